@@ -0,0 +1,144 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Resultado de um benchmark (uma linha no JSON de saída)
+struct BenchResult {
+  std::string name;
+  std::string params;
+  long iterations;
+  double nsPerOp;
+  long bytesPerOp; // 0 quando não faz sentido medir vazão
+};
+
+// Impede o compilador de descartar um valor calculado no benchmark
+template <typename T> inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T *sink;
+  sink = &value;
+#endif
+}
+
+class BenchRunner {
+public:
+  // Só roda benchmarks cujo nome contém filter (vazio = todos)
+  std::string filter;
+
+  // Roda fn() iterations vezes, REPEATS rodadas, e guarda a melhor rodada
+  // (a mínima é bem mais estável entre execuções do que a média)
+  template <typename F>
+  void run(const std::string &name, const std::string &params,
+           long iterations, F &&fn, long bytesPerOp = 0) {
+    const int REPEATS = 5;
+
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+      return;
+
+    // Aquecimento (caches, page faults, lazy init)
+    for (long i = 0; i < iterations / 10 + 1; ++i)
+      fn();
+
+    double best = -1;
+    for (int r = 0; r < REPEATS; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      for (long i = 0; i < iterations; ++i)
+        fn();
+      auto end = std::chrono::steady_clock::now();
+
+      double ns =
+          std::chrono::duration<double, std::nano>(end - start).count() /
+          iterations;
+      if (best < 0 || ns < best)
+        best = ns;
+    }
+
+    record(name, params, iterations, best, bytesPerOp);
+  }
+
+  // Como run, mas chama setup() antes de cada fn() e só cronometra fn()
+  // (para quando o estado precisa voltar ao início a cada iteração). Cada
+  // iteração paga duas leituras do relógio (~20-40 ns)
+  template <typename S, typename F>
+  void runWithSetup(const std::string &name, const std::string &params,
+                    long iterations, S &&setup, F &&fn) {
+    const int REPEATS = 5;
+
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+      return;
+
+    for (long i = 0; i < iterations / 10 + 1; ++i) {
+      setup();
+      fn();
+    }
+
+    double best = -1;
+    for (int r = 0; r < REPEATS; ++r) {
+      double total = 0;
+      for (long i = 0; i < iterations; ++i) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::nano>(end - start).count();
+      }
+
+      double ns = total / iterations;
+      if (best < 0 || ns < best)
+        best = ns;
+    }
+
+    record(name, params, iterations, best, 0);
+  }
+
+  // Imprime todos os resultados em JSON
+  void printJson(FILE *out) const {
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+      const BenchResult &r = results[i];
+      fprintf(out,
+              "    {\"name\": \"%s\", \"params\": \"%s\", \"iterations\": "
+              "%ld, \"ns_per_op\": %.1f, \"bytes_per_op\": %ld}%s\n",
+              r.name.c_str(), r.params.c_str(), r.iterations, r.nsPerOp,
+              r.bytesPerOp, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+  }
+
+  // Mesmos resultados em CSV (uma linha por benchmark)
+  void printCsv(FILE *out) const {
+    fprintf(out, "name,params,iterations,ns_per_op,bytes_per_op\n");
+    for (const BenchResult &r : results)
+      fprintf(out, "%s,%s,%ld,%.1f,%ld\n", r.name.c_str(), r.params.c_str(),
+              r.iterations, r.nsPerOp, r.bytesPerOp);
+  }
+
+private:
+  void record(const std::string &name, const std::string &params,
+              long iterations, double nsPerOp, long bytesPerOp) {
+    results.push_back({name, params, iterations, nsPerOp, bytesPerOp});
+    fprintf(stderr, "  %-28s %-18s %12.1f ns/op\n", name.c_str(),
+            params.c_str(), nsPerOp);
+  }
+
+  std::vector<BenchResult> results;
+};
+
+// Monta um snapshot do mapa fixo mapIndex com zombieCount zumbis nas
+// células livres (definido em bench_snapshot.cpp)
+struct GameSnapshot;
+void buildBenchSnapshot(GameSnapshot &s, int zombieCount, int mapIndex = 0);
+
+// Cada arquivo bench_*.cpp registra seus benchmarks aqui
+void registerSnapshotBenches(BenchRunner &runner);
+void registerPathfindingBenches(BenchRunner &runner);
+void registerGameBenches(BenchRunner &runner);
+void registerSyncBenches(BenchRunner &runner);
+void registerTimerBenches(BenchRunner &runner);
+
+#endif
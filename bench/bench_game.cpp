@@ -0,0 +1,100 @@
+#include "bench.h"
+#include "game.h"
+#include "game_runtime.h"
+#include "snapshot.h"
+#include <memory>
+#include <sstream>
+
+void registerGameBenches(BenchRunner &runner) {
+  std::unique_ptr<GameSnapshot> snap(new GameSnapshot());
+  const int zombieCounts[] = {0, 16, 256, MAX_ZOMBIES};
+
+  // isValidMove lê a tabela de ocupação: O(1), não importa o tamanho da horda
+  for (int count : zombieCounts) {
+    Game game;
+    buildBenchSnapshot(*snap, count);
+    game.restoreSnapshot(*snap);
+
+    int cell = 0;
+    runner.run("game_is_valid_move", "zombies=" + std::to_string(count),
+               100000, [&]() {
+                 Point p = {cell % GRID_WIDTH, (cell / GRID_WIDTH) % GRID_HEIGHT};
+                 cell++;
+                 bool valid = game.isValidMove(p);
+                 doNotOptimize(valid);
+               });
+  }
+
+  // Render para memória (seekp reaproveita o buffer do stream)
+  for (int count : zombieCounts) {
+    Game game;
+    buildBenchSnapshot(*snap, count);
+    game.restoreSnapshot(*snap);
+
+    std::ostringstream sink;
+    runner.run("game_draw", "zombies=" + std::to_string(count), 2000, [&]() {
+      sink.seekp(0);
+      game.draw(sink);
+      doNotOptimize(sink.tellp());
+    });
+  }
+
+  // spawnItems com parte das células livres já ocupada por itens. O
+  // restore que desfaz os itens de cada iteração fica fora do cronômetro
+  const int fillPercents[] = {0, 50, 90};
+  for (int fill : fillPercents) {
+    Game game;
+    buildBenchSnapshot(*snap, 0);
+
+    int freeCells = 0;
+    for (int y = 0; y < GRID_HEIGHT; ++y)
+      for (int x = 0; x < GRID_WIDTH; ++x)
+        if (snap->grid[y][x] == SYMBOL_EMPTY)
+          freeCells++;
+
+    int toFill = freeCells * fill / 100;
+    for (int y = 0; y < GRID_HEIGHT && toFill > 0; ++y)
+      for (int x = 0; x < GRID_WIDTH && toFill > 0; ++x)
+        if (snap->grid[y][x] == SYMBOL_EMPTY) {
+          snap->grid[y][x] = SYMBOL_ITEM;
+          toFill--;
+        }
+
+    runner.runWithSetup("game_spawn_items",
+                        "fill=" + std::to_string(fill) + "%", 20000,
+                        [&]() { game.restoreSnapshot(*snap); },
+                        [&]() { game.spawnItems(); });
+  }
+
+  // Tick completo dos zumbis (propor + resolver + aplicar) numa thread só,
+  // com todos andando. O restore de cada iteração fica fora do cronômetro
+  for (int count : {16, 256}) {
+    Game game;
+    buildBenchSnapshot(*snap, count);
+
+    runner.runWithSetup("game_update_zombies",
+                        "zombies=" + std::to_string(count), 2000,
+                        [&]() { game.restoreSnapshot(*snap); },
+                        [&]() { game.updateZombies(); });
+  }
+
+  // Reinício de rodada no lugar: mapa, zumbis, ocupação e fila do spawner
+  {
+    Game game;
+    game.init();
+    runner.run("game_reset_round", "", 2000, [&]() { game.resetRound(); });
+    game.endRound();
+  }
+
+  // Ciclo completo do runtime: acorda as threads estacionadas e estaciona
+  // de novo. Sem criar threads, tem que ficar bem abaixo de 1 ms
+  {
+    GameRuntime runtime([]() { return -1; });
+    runner.run("runtime_round_cycle", "threads=" + std::to_string(1 + ZOMBIE_THREADS),
+               500, [&]() {
+                 runtime.startRound();
+                 runtime.endRound();
+               });
+    runtime.shutdown();
+  }
+}
@@ -0,0 +1,38 @@
+#include "bench.h"
+#include "utils.h"
+#include <cstdio>
+#include <cstring>
+
+// Uso: zombie_bench [--csv] [--filter nome]
+int main(int argc, char **argv) {
+  BenchRunner runner;
+  bool csv = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--csv") == 0)
+      csv = true;
+    else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+      runner.filter = argv[++i];
+    else {
+      fprintf(stderr, "Uso: %s [--csv] [--filter nome]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  // Semente fixa: mapas e posições iguais entre execuções/commits
+  getRandomEngine().seed(42);
+
+  fprintf(stderr, "Rodando benchmarks...\n");
+  registerPathfindingBenches(runner);
+  registerGameBenches(runner);
+  registerSyncBenches(runner);
+  registerTimerBenches(runner);
+  registerSnapshotBenches(runner);
+
+  // Resultados vão para stdout, progresso para stderr
+  if (csv)
+    runner.printCsv(stdout);
+  else
+    runner.printJson(stdout);
+  return 0;
+}
@@ -0,0 +1,190 @@
+#include "bench.h"
+#include "grid.h"
+#include "influence.h"
+#include "map.h"
+#include "pathfinder.h"
+#include "visibility.h"
+#include "zombie.h"
+#include <memory>
+
+// Mapa size x size com borda de parede e o miolo do mapa fixo 0 repetido
+// (linhas/colunas 1 e 18 do mapa são livres, então os blocos se conectam)
+static std::vector<std::string> buildLargeMap(int size) {
+  const std::vector<std::string> &tile = getBuiltinMap(0);
+  const int inner = GRID_WIDTH - 2;
+
+  std::vector<std::string> map(size, std::string(size, SYMBOL_WALL));
+  for (int y = 1; y < size - 1; ++y)
+    for (int x = 1; x < size - 1; ++x)
+      map[y][x] = tile[1 + (y - 1) % inner][1 + (x - 1) % inner];
+  return map;
+}
+
+// BFS de canto a canto num mapa S x S, na instanciação do próprio tamanho
+// (grid montado uma vez, fora do laço)
+template <int S>
+static void runLargeBfs(BenchRunner &runner, long iterations) {
+  std::unique_ptr<GridT<S, S>> map(new GridT<S, S>());
+  std::unique_ptr<Pathfinder<S, S>> pathfinder(new Pathfinder<S, S>());
+  loadGrid(*map, buildLargeMap(S));
+  Point target = {S - 2, S - 2};
+
+  runner.run("zombie_bfs",
+             "size=" + std::to_string(S) + "x" + std::to_string(S),
+             iterations, [&]() {
+               Point next = pathfinder->nextStep(*map, {1, 1}, target);
+               doNotOptimize(next);
+             });
+}
+
+void registerPathfindingBenches(BenchRunner &runner) {
+  // BFS de um canto ao canto oposto (pior caso: visita o mapa todo)
+  for (int m = 0; m < getBuiltinMapCount(); ++m) {
+    Grid map;
+    loadGrid(map, getBuiltinMap(m));
+    Point target = {GRID_WIDTH - 2, GRID_HEIGHT - 2};
+
+    runner.run("zombie_bfs", "map=" + std::to_string(m), 20000, [&]() {
+      Point next = findNextStep(map, {1, 1}, target);
+      doNotOptimize(next);
+    });
+  }
+
+  // Campo de visão a partir do centro (uma vez por movimento do player)
+  for (int m = 0; m < getBuiltinMapCount(); ++m) {
+    Grid map;
+    loadGrid(map, getBuiltinMap(m));
+    Visibility field;
+    Point origin = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+
+    runner.run("visibility_compute", "map=" + std::to_string(m), 20000,
+               [&]() {
+                 field.compute(map, origin, VISION_RADIUS);
+                 doNotOptimize(field.isVisible({1, 1}));
+               });
+  }
+
+  {
+    std::unique_ptr<GridT<256, 256>> map(new GridT<256, 256>());
+    std::unique_ptr<VisibilityField<256, 256>> field(
+        new VisibilityField<256, 256>());
+    loadGrid(*map, buildLargeMap(256));
+
+    runner.run("visibility_compute", "size=256x256;radius=64", 2000, [&]() {
+      field->compute(*map, {128, 128}, 64);
+      doNotOptimize(field->isVisible({1, 1}));
+    });
+  }
+
+  // Próximo passo de um zumbi: perseguindo (mapa de influência já
+  // calculado no tick) x vagando
+  {
+    Grid map;
+    loadGrid(map, getBuiltinMap(0));
+    Visibility field;
+    Point player = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+    field.compute(map, player, VISION_RADIUS);
+
+    Point seen = {GRID_WIDTH / 2, 5};
+    Point hidden = {1, 1};
+    const char *modes[] = {"chase", "wander"};
+    for (const char *mode : modes) {
+      Point start = mode[0] == 'c' ? seen : hidden;
+      Influence influence;
+      influence.compute(map, player, &start, 1);
+      runner.run("zombie_next_move", std::string("mode=") + mode, 20000,
+                 [&]() {
+                   Zombie z(start);
+                   Point next = z.calculateNextMove(0, map, field, influence);
+                   doNotOptimize(next);
+                 });
+    }
+  }
+
+  // Perseguição da horda inteira num tick: um BFS por zumbi (como antes)
+  // x mapa de influência (dois BFS no total + O(1) por zumbi)
+  {
+    Grid map;
+    loadGrid(map, getBuiltinMap(0));
+    Point player = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+    Influence influence;
+
+    for (int count : {16, 128}) {
+      std::vector<Point> horde;
+      for (int y = 0; y < GRID_HEIGHT && (int)horde.size() < count; ++y)
+        for (int x = 0; x < GRID_WIDTH && (int)horde.size() < count; ++x)
+          if (map[y][x] == SYMBOL_EMPTY && !(Point{x, y} == player))
+            horde.push_back({x, y});
+
+      std::string params = "zombies=" + std::to_string(horde.size());
+      runner.run("horde_chase", "mode=bfs_per_zombie;" + params, 2000, [&]() {
+        for (Point z : horde)
+          doNotOptimize(findNextStep(map, z, player));
+      });
+      runner.run("horde_chase", "mode=influence;" + params, 2000, [&]() {
+        influence.compute(map, player, horde.data(), (int)horde.size());
+        for (int i = 0; i < (int)horde.size(); ++i)
+          doNotOptimize(influence.nextStep(horde[i], i));
+      });
+    }
+  }
+
+  // Flanqueio: anel de corredores em volta de um bloco de paredes, player
+  // no meio do lado de cima e dois zumbis no corredor da esquerda, um atrás
+  // do outro. Seguindo só a distância os dois subiriam em fila; com as
+  // rotas de fuga o de trás dá a volta pela direita. Uma iteração = um
+  // tick (mapa + passo de cada zumbi); routes = por quantos lados
+  // diferentes (esquerda/direita do player) eles chegaram
+  {
+    Grid map;
+    map.fill(SYMBOL_EMPTY);
+    for (int y = 0; y < GRID_HEIGHT; ++y)
+      for (int x = 0; x < GRID_WIDTH; ++x)
+        if (x == 0 || y == 0 || x == GRID_WIDTH - 1 || y == GRID_HEIGHT - 1 ||
+            (x >= 3 && x < GRID_WIDTH - 3 && y >= 3 && y < GRID_HEIGHT - 3))
+          map[y][x] = SYMBOL_WALL;
+
+    const Point player = {GRID_WIDTH / 2, 1};
+    const Point start[2] = {{2, GRID_HEIGHT / 2 + 2}, {1, GRID_HEIGHT - 2}};
+    Influence influence;
+    Point horde[2];
+
+    // Roda uma perseguição inteira antes, só para saber por onde chegaram
+    auto reset = [&]() { horde[0] = start[0], horde[1] = start[1]; };
+    auto tick = [&]() {
+      influence.compute(map, player, horde, 2);
+      for (int i = 0; i < 2; ++i)
+        if (!(horde[i] == player))
+          horde[i] = influence.nextStep(horde[i], i);
+    };
+
+    reset();
+    bool fromLeft = false, fromRight = false;
+    for (int t = 0; t < 4 * GRID_WIDTH; ++t) {
+      tick();
+      for (Point z : horde) {
+        if (z.y == player.y && z.x == player.x - 1)
+          fromLeft = true;
+        if (z.y == player.y && z.x == player.x + 1)
+          fromRight = true;
+      }
+    }
+
+    std::string params =
+        "zombies=2;routes=" + std::to_string((int)fromLeft + (int)fromRight);
+    runner.run("horde_flank", params, 20000, [&]() {
+      if (horde[0] == player && horde[1] == player)
+        reset();
+      tick();
+      doNotOptimize(horde[1]);
+    });
+  }
+
+  runLargeBfs<64>(runner, 2000);
+  runLargeBfs<256>(runner, 100);
+
+  runner.run("generate_random_map", "", 100000, []() {
+    std::vector<std::string> map = generateRandomMap();
+    doNotOptimize(map.size());
+  });
+}
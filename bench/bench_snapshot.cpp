@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "game.h"
+#include "map.h"
+#include "snapshot.h"
+#include "utils.h"
+#include <cstring>
+#include <memory>
+
+void buildBenchSnapshot(GameSnapshot &s, int zombieCount, int mapIndex) {
+  initSnapshotHeader(s);
+
+  const std::vector<std::string> &map = getBuiltinMap(mapIndex);
+  for (int y = 0; y < GRID_HEIGHT; ++y)
+    memcpy(s.grid[y], map[y].data(), GRID_WIDTH);
+
+  s.player = {{GRID_WIDTH / 2, GRID_HEIGHT / 2}, RIGHT};
+  s.score = 0;
+  s.lives = PLAYER_LIVES;
+  s.itemsRemaining = 0;
+
+  // Zumbis empilham nas células livres quando há mais zumbis que células
+  int placed = 0;
+  while (placed < zombieCount) {
+    for (int y = 0; y < GRID_HEIGHT && placed < zombieCount; ++y)
+      for (int x = 0; x < GRID_WIDTH && placed < zombieCount; ++x)
+        if (s.grid[y][x] == SYMBOL_EMPTY) {
+          int ticks = Zombie({x, y}).getMoveTicks();
+          s.zombies[placed++] = {{x, y}, NONE, 0, ticks, ticks};
+        }
+  }
+  s.zombieCount = zombieCount;
+
+  s.spawnBatchCount = 0;
+  s.waveNumber = 0;
+  s.nextWaveIn = WAVE_INTERVAL_MS / TIMER_TICK_MS;
+  s.activeZombies = zombieCount;
+  s.rng = getRandomEngine();
+  s.spawnerRng = getRandomEngine();
+}
+
+void registerSnapshotBenches(BenchRunner &runner) {
+  // O grid tem tamanho fixo (GRID_WIDTH x GRID_HEIGHT), então só o número
+  // de entidades varia aqui
+  const int zombieCounts[] = {0, 16, 256, MAX_ZOMBIES};
+
+  std::unique_ptr<GameSnapshot> source(new GameSnapshot());
+  std::unique_ptr<GameSnapshot> target(new GameSnapshot());
+
+  for (int count : zombieCounts) {
+    Game game;
+    buildBenchSnapshot(*source, count);
+    game.restoreSnapshot(*source);
+
+    std::string params = "zombies=" + std::to_string(count);
+
+    runner.run("snapshot_save", params, 20000, [&]() {
+      game.saveSnapshot(*target);
+      doNotOptimize(target->zombieCount);
+    }, sizeof(GameSnapshot));
+
+    runner.run("snapshot_restore", params, 20000, [&]() {
+      bool ok = game.restoreSnapshot(*source);
+      doNotOptimize(ok);
+    }, sizeof(GameSnapshot));
+  }
+}
@@ -0,0 +1,88 @@
+#include "bench.h"
+#include "map.h"
+#include "semaphore.h"
+#include "zombie_spawner.h"
+#include <atomic>
+#include <thread>
+
+void registerSyncBenches(BenchRunner &runner) {
+  // Ida e volta entre duas threads usando dois semáforos
+  {
+    Semaphore ping(0), pong(0);
+    std::atomic<bool> stop(false);
+
+    std::thread partner([&]() {
+      while (true) {
+        ping.wait();
+        if (stop)
+          break;
+        pong.signal();
+      }
+    });
+
+    runner.run("semaphore_ping_pong", "threads=2", 20000, [&]() {
+      ping.signal();
+      pong.wait();
+    });
+
+    stop = true;
+    ping.signal();
+    partner.join();
+  }
+
+  // Produtor/consumidor do spawner: uma thread empurra lotes enquanto o
+  // consumidor (o jogo) faz polling sem bloquear
+  const int batchSizes[] = {1, 256};
+  for (int batchSize : batchSizes) {
+    ZombieSpawner spawner;
+    std::atomic<bool> stop(false);
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+      std::vector<Point> batch;
+      batch.reserve(MAX_ZOMBIES);
+      while (!stop) {
+        batch.assign(batchSize, {1, 1});
+        spawner.pushSpawnBatch(batch);
+      }
+      done = true;
+    });
+
+    std::vector<Point> received;
+    received.reserve(MAX_ZOMBIES);
+    runner.run("spawner_handoff", "batch=" + std::to_string(batchSize),
+               20000, [&]() {
+                 while (!spawner.consumeSpawnBatch(received)) {
+                 }
+                 doNotOptimize(received.size());
+               });
+
+    // Libera o produtor caso ele esteja bloqueado com o buffer cheio
+    stop = true;
+    while (!done)
+      spawner.consumeSpawnBatch(received);
+    producer.join();
+  }
+
+  // Sorteio de uma onda: BFS a partir do player + amostragem sem repetição
+  const int waveSizes[] = {3, 64, 256};
+  for (int waveSize : waveSizes) {
+    Point playerPos = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+    WaveSettings settings;
+    settings.firstSize = waveSize;
+    settings.growth = 0;
+
+    ZombieSpawner spawner(settings);
+    Grid map;
+    loadGrid(map, getBuiltinMap(0));
+    spawner.setMap(map);
+
+    std::vector<Point> batch;
+    batch.reserve(MAX_ZOMBIES);
+    runner.run("spawner_generate_wave", "wave=" + std::to_string(waveSize),
+               20000, [&]() {
+                 spawner.generateWave(batch, playerPos);
+                 doNotOptimize(batch.size());
+               });
+  }
+}
@@ -0,0 +1,58 @@
+#include "bench.h"
+#include "config.h"
+#include "timer_wheel.h"
+#include <vector>
+
+void registerTimerBenches(BenchRunner &runner) {
+  // Milhares de entidades, cada uma no seu intervalo (20 a 120 ticks).
+  // Uma iteração = um tick da roda: avança, e cada timer vencido é
+  // reagendado com o intervalo da sua entidade
+  const int entityCounts[] = {1000, 10000};
+  for (int count : entityCounts) {
+    TimerWheel wheel(count);
+    std::vector<uint32_t> period(count);
+    for (int i = 0; i < count; ++i) {
+      period[i] = 20 + (uint32_t)(i * 7919) % 101;
+      wheel.schedule(1 + i % period[i], TIMER_ZOMBIE_MOVE, i);
+    }
+
+    std::vector<TimerEvent> due;
+    due.reserve(count);
+    runner.run("timer_wheel_tick", "entities=" + std::to_string(count),
+               20000, [&]() {
+                 due.clear();
+                 wheel.advance(wheel.now() + 1, due);
+                 for (const TimerEvent &e : due)
+                   wheel.schedule(period[e.target], e.kind, e.target);
+                 doNotOptimize(due.size());
+               });
+  }
+
+  // Agendar + cancelar um timer com a roda já cheia de pendentes
+  {
+    TimerWheel wheel(TIMER_CAPACITY);
+    for (int i = 0; i < TIMER_CAPACITY - 1; ++i)
+      wheel.schedule(1 + (uint32_t)(i * 131) % 100000, TIMER_ZOMBIE_MOVE, i);
+
+    uint32_t delay = 1;
+    runner.run("timer_wheel_schedule_cancel",
+               "pending=" + std::to_string(TIMER_CAPACITY - 1), 200000, [&]() {
+                 delay = delay * 1103515245u + 12345u;
+                 TimerWheel::TimerId id =
+                     wheel.schedule(1 + delay % 100000, TIMER_ZOMBIE_MOVE, 0);
+                 wheel.cancel(id);
+                 doNotOptimize(id);
+               });
+  }
+
+  // Próximo vencimento (o agendador pergunta a cada vez que vai dormir)
+  {
+    TimerWheel wheel(TIMER_CAPACITY);
+    for (int i = 0; i < TIMER_CAPACITY; ++i)
+      wheel.schedule(20 + (uint32_t)(i * 7919) % 101, TIMER_ZOMBIE_MOVE, i);
+
+    runner.run("timer_wheel_next_expiry",
+               "pending=" + std::to_string(TIMER_CAPACITY), 200000,
+               [&]() { doNotOptimize(wheel.nextExpiry()); });
+  }
+}
@@ -0,0 +1,76 @@
+#include "alloc_counter.h"
+
+#ifdef ALLOC_COUNTER
+
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static thread_local long threadAllocs = 0;
+
+// As versões de array (new[]/delete[]) padrão chamam estas
+void *operator new(std::size_t size) {
+  threadAllocs++;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  threadAllocs++;
+  return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Tipos com alignas acima do padrão (ex.: alinhados à linha de cache)
+// vêm por aqui. aligned_alloc quer o tamanho múltiplo do alinhamento; no
+// Windows não existe e a memória volta por _aligned_free
+static void *alignedMalloc(std::size_t size, std::align_val_t align) {
+  std::size_t a = (std::size_t)align;
+  std::size_t rounded = (size + a - 1) / a * a;
+#ifdef _WIN32
+  return _aligned_malloc(rounded ? rounded : a, a);
+#else
+  return std::aligned_alloc(a, rounded ? rounded : a);
+#endif
+}
+
+static void alignedFree(void *p) {
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  threadAllocs++;
+  if (void *p = alignedMalloc(size, align))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+  threadAllocs++;
+  return alignedMalloc(size, align);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  alignedFree(p);
+}
+
+long threadAllocationCount() { return threadAllocs; }
+bool allocationCounterEnabled() { return true; }
+
+#else
+
+long threadAllocationCount() { return 0; }
+bool allocationCounterEnabled() { return false; }
+
+#endif
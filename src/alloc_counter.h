@@ -0,0 +1,14 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// Com -DALLOC_COUNTER (make DEBUG=1) o operator new global é substituído
+// por uma versão que conta chamadas por thread. Sem a flag, tudo é zero
+// e não há custo nenhum
+
+// Quantas vezes a thread atual chamou operator new
+long threadAllocationCount();
+
+// true se o contador está compilado
+bool allocationCounterEnabled();
+
+#endif
@@ -8,9 +8,30 @@ const int GRID_WIDTH = 20;
 const int GRID_HEIGHT = 20;
 const int GAME_DURATION_SECONDS = 60;     // Tempo total do jogo
 const int TICK_RATE_MS = 500;             // Velocidade de movimento do player
-const int ZOMBIE_COUNT = 3;
+const int PLAYER_LIVES = 3;               // Vidas no começo da rodada
+const int ZOMBIE_THREADS = 3;             // Threads que movem os zumbis
+const int MAX_ZOMBIES = 1024;             // Capacidade máxima (buffers e snapshot)
+const int SPAWN_QUEUE_CAPACITY = 3;       // Lotes no buffer do spawner
 const int ITEMS_BATCH_SIZE = 5;
 const float ZOMBIE_SPEED_MODIFIER = 0.9f; // Zumbis se movem a 90% da velocidade do player
+const int VISION_RADIUS = 10;             // Até onde os zumbis enxergam o player
+
+// --- Ondas de zumbis ---
+const int WAVE_INTERVAL_MS = 6000;        // Tempo entre ondas
+const int WAVE_FIRST_SIZE = 3;            // Zumbis na primeira onda
+const int WAVE_GROWTH = 2;                // Zumbis a mais a cada onda
+const int SPAWN_MIN_DISTANCE = 8;         // Passos mínimos entre spawn e player
+
+// --- Agendador (timer wheel) ---
+const int TIMER_TICK_MS = 10;             // Resolução do agendador
+const int TIMER_CAPACITY = MAX_ZOMBIES + 16; // Ações pendentes ao mesmo tempo
+const int ZOMBIE_SPEED_SPREAD = 30;       // Cada zumbi varia até ±30% da velocidade base
+const int ITEM_RESPAWN_MS = 1500;         // Espera até o próximo lote de itens
+const int SOUND_COOLDOWN_MS = 300;        // Intervalo mínimo entre dois sons iguais
+
+// --- Trace (--trace) ---
+const int TRACE_BUFFER_EVENTS = 1 << 15;  // Eventos por thread (o resto é descartado)
+const char *const TRACE_FILE = "trace.json";
 
 // --- Símbolos ---
 const char SYMBOL_PLAYER = 'P';
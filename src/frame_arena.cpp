@@ -0,0 +1,75 @@
+#include "frame_arena.h"
+#include "alloc_counter.h"
+#include <cassert>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t blockSize)
+    : current(0), offset(0), blockSize(blockSize) {}
+
+void *FrameArena::allocBytes(size_t bytes, size_t align) {
+  while (true) {
+    if (current < blocks.size()) {
+      Block &block = blocks[current];
+      uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+      size_t aligned = (size_t)(((base + offset + align - 1) & ~(align - 1)) - base);
+
+      if (aligned + bytes <= block.size) {
+        offset = aligned + bytes;
+        return block.data.get() + aligned;
+      }
+
+      // Não coube: passa para o próximo bloco já alocado (se houver)
+      if (current + 1 < blocks.size()) {
+        current++;
+        offset = 0;
+        continue;
+      }
+    }
+
+    // Sem espaço em nenhum bloco: cresce (só acontece nos primeiros ticks)
+    size_t size = blockSize;
+    if (bytes + align > size)
+      size = bytes + align;
+    blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    current = blocks.size() - 1;
+    offset = 0;
+  }
+}
+
+void FrameArena::reset() {
+  current = 0;
+  offset = 0;
+}
+
+void FrameArena::rewind(Marker m) {
+  current = m.block;
+  offset = m.offset;
+}
+
+size_t FrameArena::used() const {
+  size_t total = offset;
+  for (size_t i = 0; i < current && i < blocks.size(); ++i)
+    total += blocks[i].size;
+  return total;
+}
+
+FrameArena &threadArena() {
+  static thread_local FrameArena arena;
+  return arena;
+}
+
+// Ticks iniciais de cada thread em que alocações ainda são esperadas
+static const int WARMUP_TICKS = 2;
+static thread_local int ticksSeen = 0;
+
+FrameTick::FrameTick() : allocsAtStart(threadAllocationCount()) {}
+
+FrameTick::~FrameTick() {
+  threadArena().reset();
+
+  if (++ticksSeen > WARMUP_TICKS) {
+    long allocs = threadAllocationCount() - allocsAtStart;
+    (void)allocs;
+    assert(allocs == 0 && "operator new chamado dentro de um tick");
+  }
+}
@@ -0,0 +1,80 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Alocador "bump" para dados temporários de um tick. Cada thread tem a
+// sua (threadArena()), então não há disputa pelo malloc entre as threads
+// de zumbis. Alocar é só avançar um ponteiro; no fim do tick tudo é
+// liberado de uma vez com reset(). Os blocos ficam guardados: depois do
+// primeiro tick a arena não chama mais operator new
+class FrameArena {
+public:
+  static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+  // Reserva count objetos T (memória não inicializada, sem destrutor)
+  template <typename T> T *alloc(size_t count) {
+    return static_cast<T *>(allocBytes(count * sizeof(T), alignof(T)));
+  }
+
+  // Libera tudo o que foi alocado desde o último reset
+  void reset();
+
+  // Posição atual, para devolver só o que foi alocado depois dela
+  struct Marker {
+    size_t block;
+    size_t offset;
+  };
+  Marker mark() const { return {current, offset}; }
+  void rewind(Marker m);
+
+  // Bytes em uso no momento (para debug/benchmarks)
+  size_t used() const;
+
+private:
+  void *allocBytes(size_t bytes, size_t align);
+
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks;
+  size_t current; // Bloco em uso
+  size_t offset;  // Próximo byte livre dentro do bloco atual
+  size_t blockSize;
+};
+
+// Arena da thread atual
+FrameArena &threadArena();
+
+// Devolve à arena, no fim do escopo, tudo o que foi alocado dentro dele.
+// Para funções que usam a arena e também são chamadas fora de um tick
+class ArenaScope {
+public:
+  explicit ArenaScope(FrameArena &arena) : arena(arena), start(arena.mark()) {}
+  ~ArenaScope() { arena.rewind(start); }
+
+private:
+  FrameArena &arena;
+  FrameArena::Marker start;
+};
+
+// Marca um tick no loop de uma thread. Ao sair do escopo zera a arena da
+// thread e, compilado com ALLOC_COUNTER (make DEBUG=1), verifica que o
+// tick não chamou operator new. Os primeiros ticks de cada thread ficam
+// de fora (inicialização preguiçosa de buffers)
+class FrameTick {
+public:
+  FrameTick();
+  ~FrameTick();
+
+private:
+  long allocsAtStart;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// Buffer de tela de tamanho fixo para um grid W x H. O frame inteiro é
+// montado aqui e escrito de uma vez, sem formatação via iostream
+template <int W, int H> class FrameBuffer {
+public:
+  // Pior caso por célula: cor + símbolo + reset + espaço
+  static constexpr int MAX_CELL_BYTES = 16;
+  static constexpr int HEADER_BYTES = 128;
+  static constexpr int Capacity = HEADER_BYTES + H * (W * MAX_CELL_BYTES + 1);
+
+  FrameBuffer() : length(0) {}
+
+  void clear() { length = 0; }
+
+  void append(char c) {
+    if (length < Capacity)
+      buffer[length++] = c;
+  }
+
+  void append(const char *s) {
+    size_t n = strlen(s);
+    if (n > Capacity - length)
+      n = Capacity - length;
+    memcpy(buffer.data() + length, s, n);
+    length += n;
+  }
+
+  void append(int value) {
+    char digits[16];
+    int n = snprintf(digits, sizeof(digits), "%d", value);
+    if (n > 0)
+      append(digits);
+  }
+
+  const char *data() const { return buffer.data(); }
+  size_t size() const { return length; }
+
+private:
+  std::array<char, Capacity> buffer;
+  size_t length;
+};
+
+#endif
@@ -1,7 +1,10 @@
 #include "game.h"
 #include "zombie_spawner.h"
 #include "map.h"
+#include "trace.h"
 #include "utils.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -12,25 +15,69 @@ Game::~Game() {
   }
 }
 
-Game::Game() : score(0), lives(3), itemsRemaining(0), running(true) {
+Game::Game()
+    : timers(TIMER_CAPACITY), wakeTick(0), waveTimer(TimerWheel::NO_TIMER),
+      itemTimer(TimerWheel::NO_TIMER), score(0), lives(PLAYER_LIVES), itemsRemaining(0), running(true), started(false) {
   player.facing = RIGHT; // Direção inicial
-  spawner = new ZombieSpawner(&player.pos);
+  grid.fill(SYMBOL_WALL);
+  occupancy.fill(0);
+  zombies.reserve(MAX_ZOMBIES);
+  spawnBatch.reserve(MAX_ZOMBIES);
+  proposals.reserve(MAX_ZOMBIES);
+  zombiePositions.reserve(MAX_ZOMBIES);
+  dueTimers.reserve(TIMER_CAPACITY);
+  moveDue.reserve(MAX_ZOMBIES);
+  soundCooling[0] = soundCooling[1] = false;
+  spawner = new ZombieSpawner();
 }
 
 void Game::init() {
-  std::lock_guard<std::mutex> lock(gameMutex);
+  // Threads que sobrevivem entre rodadas
+  if (!started) {
+    spawner->start();
+    initSoundEffects();
+    started = true;
+  }
+
+  resetRound();
+}
+
+void Game::resetRound() {
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  std::lock_guard<std::mutex> lifeLock(livesMutex);
 
   // 1. Criar um grid aleatório
-  grid = generateRandomMap();
+  loadGrid(grid, pickRandomMap());
 
   // 2. Colocar o player no centro
   player.pos = {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+  player.facing = RIGHT;
+  visibility.compute(grid, player.pos, VISION_RADIUS);
+
+  // 3. Zerar estado da rodada (clear mantém a capacidade reservada)
+  score = 0;
+  lives = PLAYER_LIVES;
+  zombies.clear();
+  occupancy.fill(0);
+  timers.clear(); // Relógio da rodada volta a 0
+  roundClock = std::chrono::steady_clock::now();
+  wakeTick = 0;
+  soundCooling[0] = soundCooling[1] = false;
+
+  // 4. Reiniciar as ondas do spawner (ele precisa das paredes do mapa)
+  spawner->beginRound(grid);
+  scheduleWave(0);
+
+  // 5. Colocar os itens iniciais
+  itemTimer = TimerWheel::NO_TIMER;
+  spawnItems();
 
-  // 3. Iniciar o spawner de zumbis
-  spawner->start();
+  running = true;
+}
 
-  // 4. Colocar os itens iniciais
-  spawnItems();
+void Game::endRound() {
+  running = false;
+  spawner->endRound();
 }
 
 void Game::spawnItems() {
@@ -46,23 +93,68 @@ void Game::spawnItems() {
   itemsRemaining = ITEMS_BATCH_SIZE;
 }
 
-// Pega os zumbis do buffer do spawner
+// Pega os lotes de zumbis do buffer do spawner
 void Game::checkNewZombies() {
-  Point spawnPos;
-
-  // Tenta consumir um zumbi (retorna false se não tiver nenhum pronto)
-  if (spawner->consumeSpawnPosition(spawnPos)) {
-    std::lock_guard<std::mutex> lock(gameMutex);
-    // Cria o objeto Zombie e adiciona ao vetor
-    zombies.emplace_back(spawnPos);
+  TRACE_SCOPE("checkNewZombies");
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  int dropped = 0;
+
+  // Consome todos os lotes prontos de uma vez (false = nenhum pronto)
+  while (spawner->consumeSpawnBatch(spawnBatch)) {
+    for (Point spawnPos : spawnBatch) {
+      // Célula ocupada desde o sorteio: o zumbi não entra
+      if (spawnPos == player.pos || !isValidMove(spawnPos)) {
+        dropped++;
+        continue;
+      }
+      // Cria o objeto Zombie e adiciona ao vetor
+      addZombie(Zombie(spawnPos));
+    }
   }
+
+  if (dropped > 0)
+    spawner->releaseZombies(dropped);
+}
+
+// Helpers de zumbis: mantêm occupancy e os timers em dia. Chamar com
+// gameMutex travado. firstMoveIn = 0: primeiro passo após um intervalo
+void Game::addZombie(const Zombie &z, uint32_t firstMoveIn) {
+  zombies.push_back(z);
+  occupancy.at(z.getZombiePosition())++;
+
+  int index = (int)zombies.size() - 1;
+  uint32_t delay = firstMoveIn > 0 ? firstMoveIn : z.getMoveTicks();
+  zombies[index].setMoveTimer(
+      scheduleTimer(delay, TIMER_ZOMBIE_MOVE, index));
+}
+
+void Game::moveZombie(int zombieIndex, Point p) {
+  occupancy.at(zombies[zombieIndex].getZombiePosition())--;
+  zombies[zombieIndex].setPosition(p);
+  occupancy.at(p)++;
+}
+
+// Tira o zumbi do jogo (troca com o último para não deslocar o vetor)
+void Game::removeZombie(int zombieIndex) {
+  occupancy.at(zombies[zombieIndex].getZombiePosition())--;
+  timers.cancel(zombies[zombieIndex].getMoveTimer());
+
+  zombies[zombieIndex] = zombies.back();
+  zombies.pop_back();
+  // O timer do zumbi que veio do fim passa a apontar para o novo índice
+  if (zombieIndex < (int)zombies.size())
+    timers.retarget(zombies[zombieIndex].getMoveTimer(), zombieIndex);
+
+  spawner->releaseZombies(1);
 }
 
 void Game::updatePlayer() {
+  TRACE_SCOPE("updatePlayer");
+
   // Verifica se chegaram novos zumbis antes de mover
   checkNewZombies();
 
-  std::lock_guard<std::mutex> lock(gameMutex);
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
   if (!running)
     return;
 
@@ -71,11 +163,14 @@ void Game::updatePlayer() {
   if (isValidMove(next)) {
     player.pos = next;
     checkItemCollection(next);
+
+    // Uma vez por movimento, para todos os zumbis
+    visibility.compute(grid, player.pos, VISION_RADIUS);
   }
 }
 
 void Game::setPlayerDirection(Direction d) {
-  std::lock_guard<std::mutex> lock(gameMutex);
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
   player.facing = d;
 }
 
@@ -101,110 +196,385 @@ Point Game::getNextPosition(Point current, Direction dir) {
 }
 
 bool Game::isValidMove(Point p) {
-  if (p.x < 0 || p.x >= GRID_WIDTH || p.y < 0 || p.y >= GRID_HEIGHT)
+  if (!Grid::inBounds(p))
     return false;
-  if (grid[p.y][p.x] == SYMBOL_WALL)
+  if (grid.at(p) == SYMBOL_WALL)
     return false;
-
-  for (auto &z : zombies) {
-    if (z.getZombiePosition() == p)
-      return false;
-  }
-  return true;
+  return occupancy.at(p) == 0;
 }
 
 void Game::checkItemCollection(Point p) {
   if (grid[p.y][p.x] == SYMBOL_ITEM) {
-    playSoundEffect(0); // Som de coleta
+    playSound(0); // Som de coleta
     score += 10;
     grid[p.y][p.x] = SYMBOL_EMPTY;
     itemsRemaining--;
-    if (itemsRemaining <= 0) {
-      spawnItems();
-    }
+
+    // Novo lote depois de um tempo, pelo agendador
+    if (itemsRemaining <= 0 && itemTimer == TimerWheel::NO_TIMER)
+      itemTimer = scheduleTimer(ITEM_RESPAWN_MS / TIMER_TICK_MS,
+                                TIMER_ITEM_RESPAWN, 0);
   }
 }
 
 void Game::handleDamaging() {
   std::lock_guard<std::mutex> lifeLock(livesMutex);
-  playSoundEffect(1); // Som de dano
+  playSound(1); // Som de dano
   lives--;
   if (lives <= 0)
     running = false;
   return;
 }
 
-// Atualiza a posição do zumbi
-void Game::updateZombie(int zombieIndex) {
-  Point newPos;
+#ifdef BENCH_HOOKS
+// Atualiza todos os zumbis (propõe -> resolve -> aplica)
+void Game::updateZombies() {
+  TRACE_SCOPE("updateZombies");
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  if (!running)
+    return;
+
+  // Todos andam (sem olhar os timers)
+  moveDue.assign(zombies.size(), 1);
+  stepZombies(nullptr);
+}
+#endif
 
-  {
-    std::lock_guard<std::mutex> lock(gameMutex);
-    if (!running || zombieIndex >= (int)zombies.size())
-      return;
+void Game::runTimers(const std::function<void()> &proposeAll) {
+  TRACE_SCOPE("runTimers");
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  if (!running)
+    return;
 
-    // Calcula a próxima posição, mas ainda não move o zumbi
-    newPos = zombies[zombieIndex].calculateNextMove(player.pos, grid);
+  uint64_t to = timerNow();
+  if (to <= timers.now())
+    return;
+
+  dueTimers.clear();
+  timers.advance(to, dueTimers);
+  TRACE_COUNTER("dueTimers", (int64_t)dueTimers.size());
+
+  moveDue.assign(zombies.size(), 0);
+  int moving = 0;
+
+  for (const TimerEvent &e : dueTimers) {
+    switch (e.kind) {
+    case TIMER_ZOMBIE_MOVE: {
+      // Já agenda o próximo passo, na velocidade deste zumbi
+      Zombie &z = zombies[e.target];
+      z.setMoveTimer(
+          scheduleTimer(z.getMoveTicks(), TIMER_ZOMBIE_MOVE, e.target));
+      moveDue[e.target] = 1;
+      moving++;
+      break;
+    }
+    case TIMER_SPAWN_WAVE:
+      spawner->requestWave(player.pos);
+      scheduleWave(0);
+      break;
+    case TIMER_ITEM_RESPAWN:
+      itemTimer = TimerWheel::NO_TIMER;
+      spawnItems();
+      break;
+    case TIMER_SOUND_COOLDOWN:
+      soundCooling[e.target] = false;
+      break;
+    }
   }
 
+  if (moving > 0)
+    stepZombies(proposeAll);
+}
+
+// Um tick em duas fases para os zumbis marcados em moveDue. Chamar com
+// gameMutex travado
+void Game::stepZombies(const std::function<void()> &proposeAll) {
+  proposals.resize(zombies.size()); // Cabe na reserva: sem alocar
+  TRACE_COUNTER("zombies", (int64_t)zombies.size());
+
+  // Um BFS do player + um BFS de todos os zumbis juntos, para o tick todo
   {
-    // Entrando na região crítica
-    std::lock_guard<std::mutex> lock(gameMutex);
-
-    // Verifica se a nova posição é válida
-    if (isValidMove(newPos)) {
-      // Se válido, movemos o zumbi explicitamente
-      if (newPos.x == player.pos.x && newPos.y == player.pos.y) {
-        handleDamaging();
-        return;
+    TRACE_SCOPE("influence");
+    zombiePositions.clear();
+    for (const Zombie &z : zombies)
+      zombiePositions.push_back(z.getZombiePosition());
+    influence.compute(grid, player.pos, zombiePositions.data(),
+                      (int)zombiePositions.size());
+  }
+  if (proposeAll)
+    proposeAll();
+  else
+    proposeZombieMoves(0, 1);
+
+  TRACE_SCOPE("resolveZombieMoves");
+  resolveZombieMoves();
+}
+
+void Game::proposeZombieMoves(int first, int stride) {
+  TRACE_SCOPE("proposeZombieMoves");
+  for (int i = first; i < (int)proposals.size(); i += stride) {
+    if (!moveDue[i]) {
+      proposals[i] = zombies[i].getZombiePosition(); // Não é a vez dele
+      continue;
+    }
+    proposals[i] =
+        zombies[i].calculateNextMove(i, grid, visibility, influence);
+  }
+}
+
+// delayTicks = 0: um intervalo de onda inteiro
+void Game::scheduleWave(uint32_t delayTicks) {
+  if (delayTicks == 0)
+    delayTicks = spawner->getWaveIntervalMs() / TIMER_TICK_MS;
+  waveTimer = scheduleTimer(delayTicks, TIMER_SPAWN_WAVE, 0);
+}
+
+// Tick em que a rodada está de fato. A roda só anda no agendador, que
+// pode estar dormindo até o próximo prazo: nesse meio tempo timers.now()
+// fica para trás
+uint64_t Game::timerNow() const {
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - roundClock)
+                     .count();
+  return std::max(timers.now(), (uint64_t)(elapsed / TIMER_TICK_MS));
+}
+
+// Agenda a partir do relógio da rodada (não do da roda) e acorda o
+// agendador se o novo timer vence antes do prazo com que ele dormiu.
+// Chamar com gameMutex travado
+TimerWheel::TimerId Game::scheduleTimer(uint32_t delayTicks, TimerKind kind,
+                                        int32_t target) {
+  uint64_t lag = timerNow() - timers.now();
+  TimerWheel::TimerId id =
+      timers.schedule(delayTicks + (uint32_t)lag, kind, target);
+
+  uint64_t expires = timers.now() + timers.remaining(id);
+  if (id != TimerWheel::NO_TIMER && expires < wakeTick) {
+    wakeTick = expires;
+    if (timerWakeup)
+      timerWakeup();
+  }
+  return id;
+}
+
+// Ticks até o timer vencer a partir de now = timerNow() (mínimo 1:
+// ausente ou atrasado, vence no próximo tick). Chamar com gameMutex travado
+uint32_t Game::timerRemaining(TimerWheel::TimerId id, uint64_t now) const {
+  uint64_t expires = timers.now() + timers.remaining(id);
+  return expires > now ? (uint32_t)(expires - now) : 1;
+}
+
+std::chrono::steady_clock::time_point Game::nextTimerDeadline() {
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  wakeTick = timers.nextExpiry();
+
+  // Roda vazia: confere de novo em um intervalo de onda
+  if (wakeTick == TimerWheel::NO_EXPIRY)
+    wakeTick = timerNow() + WAVE_INTERVAL_MS / TIMER_TICK_MS;
+  return roundClock + std::chrono::milliseconds(wakeTick * TIMER_TICK_MS);
+}
+
+void Game::setTimerWakeup(const std::function<void()> &wake) {
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  timerWakeup = wake;
+}
+
+// Toca o som se ele não estiver em cooldown. Chamar com gameMutex travado
+void Game::playSound(int type) {
+  if (soundCooling[type])
+    return;
+  soundCooling[type] = true;
+  playSoundEffect(type);
+  scheduleTimer(SOUND_COOLDOWN_MS / TIMER_TICK_MS, TIMER_SOUND_COOLDOWN, type);
+}
+
+// Resolve os conflitos das propostas e aplica os vencedores em lote.
+// Regras (repetidas até ninguém mais ser rejeitado):
+// - quem fica parado é dono da própria célula
+// - duas propostas para a mesma célula: vence o menor índice
+// - dois zumbis trocando de lugar: os dois ficam
+// Um rejeitado passa a ficar parado e pode derrubar quem entrou na célula
+// dele, por isso a repetição. Chamar com gameMutex travado
+void Game::resolveZombieMoves() {
+  const int n = (int)zombies.size();
+
+  occupants.clear();
+  for (int i = 0; i < n; ++i) {
+    Point from = zombies[i].getZombiePosition();
+    occupants.claim(from, i);
+
+    // Parede ou fora do mapa: fica onde está
+    Point to = proposals[i];
+    if (!Grid::inBounds(to) || grid.at(to) == SYMBOL_WALL)
+      proposals[i] = from;
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    reservations.clear();
+
+    for (int i = 0; i < n; ++i)
+      if (proposals[i] == zombies[i].getZombiePosition())
+        reservations.claim(proposals[i], i);
+
+    for (int i = 0; i < n; ++i) {
+      Point from = zombies[i].getZombiePosition();
+      Point to = proposals[i];
+      if (to == from)
+        continue;
+
+      int other = occupants.ownerAt(to);
+      bool swap = other != ReservationTable::NO_OWNER && proposals[other] == from;
+      if (swap || !reservations.claim(to, i)) {
+        proposals[i] = from;
+        changed = true;
       }
-      zombies[zombieIndex].setPosition(newPos);
+    }
+  }
+
+  // Aplica os movimentos vencedores de uma vez
+  for (int i = 0; i < n; ++i) {
+    Point to = proposals[i];
+    if (to == zombies[i].getZombiePosition() || to == player.pos)
+      continue;
+    moveZombie(i, to);
+  }
+
+  // Mordidas consomem o zumbi: do maior índice para o menor, assim o
+  // swap-pop de removeZombie só traz zumbis já processados
+  for (int i = n - 1; i >= 0; --i) {
+    if (proposals[i] == player.pos &&
+        !(zombies[i].getZombiePosition() == player.pos)) {
+      handleDamaging();
+      removeZombie(i);
     }
   }
 }
 
-void Game::draw() {
-  std::lock_guard<std::mutex> lock(gameMutex);
+void Game::saveSnapshot(GameSnapshot &out) {
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  std::lock_guard<std::mutex> lifeLock(livesMutex);
+
+  initSnapshotHeader(out);
+
+  memcpy(out.grid, grid.cells.data(), Grid::Size);
+
+  out.player = player;
+  out.score = score;
+  out.lives = lives;
+  out.itemsRemaining = itemsRemaining;
+
+  uint64_t now = timerNow();
+  int n = (int)zombies.size();
+  if (n > MAX_ZOMBIES)
+    n = MAX_ZOMBIES;
+  out.zombieCount = n;
+  for (int i = 0; i < n; ++i) {
+    out.zombies[i].pos = zombies[i].getZombiePosition();
+    out.zombies[i].heading = zombies[i].getHeading();
+    out.zombies[i].rngState = zombies[i].getRngState();
+    out.zombies[i].moveTicks = zombies[i].getMoveTicks();
+    // Timer ausente (pool cheio) vira "anda no próximo tick"
+    out.zombies[i].nextMoveIn = timerRemaining(zombies[i].getMoveTimer(), now);
+  }
+
+  out.spawnBatchCount =
+      spawner->copySpawnQueue(out.spawnQueue, MAX_ZOMBIES,
+                              out.spawnBatchSizes, SPAWN_QUEUE_CAPACITY);
+  out.activeZombies = spawner->getCurrentZombieCount();
+  out.waveNumber = spawner->getWaveNumber();
+  out.nextWaveIn = timerRemaining(waveTimer, now);
+
+  spawner->copyRng(out.spawnerRng);
+  out.rng = getRandomEngine();
+}
+
+bool Game::restoreSnapshot(const GameSnapshot &in) {
+  if (!isSnapshotValid(in))
+    return false;
+
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  std::lock_guard<std::mutex> lifeLock(livesMutex);
+
+  memcpy(grid.cells.data(), in.grid, Grid::Size);
+
+  player = in.player;
+  score = in.score;
+  lives = in.lives;
+  itemsRemaining = in.itemsRemaining;
+  running = lives > 0;
+
+  // Timers pendentes saem do snapshot; o relógio continua onde está
+  zombies.clear();
+  occupancy.fill(0);
+  timers.clear(timerNow());
+  soundCooling[0] = soundCooling[1] = false;
+  for (int i = 0; i < in.zombieCount; ++i) {
+    const ZombieRecord &z = in.zombies[i];
+    addZombie(Zombie(z.pos, (Direction)z.heading, z.rngState, z.moveTicks),
+              (uint32_t)z.nextMoveIn);
+  }
+  visibility.compute(grid, player.pos, VISION_RADIUS);
+
+  scheduleWave((uint32_t)in.nextWaveIn);
+  itemTimer = TimerWheel::NO_TIMER;
+  if (itemsRemaining <= 0)
+    itemTimer = scheduleTimer(ITEM_RESPAWN_MS / TIMER_TICK_MS,
+                              TIMER_ITEM_RESPAWN, 0);
+
+  // isSnapshotValid já garante que os lotes cabem: false aqui é bug
+  getRandomEngine() = in.rng;
+  return spawner->restoreRound(grid, in.spawnQueue, in.spawnBatchSizes,
+                               in.spawnBatchCount, in.activeZombies,
+                               in.waveNumber, in.spawnerRng);
+}
+
+void Game::draw(std::ostream &out) {
+  TRACE_SCOPE("draw");
+  TracedLockGuard lock(gameMutex, "wait gameMutex");
+  frame.clear();
 
   // Move o cursor para o topo esquerdo
-  std::cout << "\033[H";
+  frame.append("\033[H");
 
   // Imprime o header
-  std::cout << "SCORE: " << score << " | LIVES: " << lives
-            << " | ZOMBIES: " << zombies.size() << "\n";
+  frame.append("SCORE: ");
+  frame.append(score);
+  frame.append(" | LIVES: ");
+  frame.append(lives);
+  frame.append(" | ZOMBIES: ");
+  frame.append((int)zombies.size());
+  frame.append('\n');
 
   // Desenha o grid
   for (int y = 0; y < GRID_HEIGHT; ++y) {
     for (int x = 0; x < GRID_WIDTH; ++x) {
-      bool dynamicDrawn = false;
-
       // Desenha o Player
       if (player.pos.x == x && player.pos.y == y) {
-        std::cout << COLOR_PLAYER << SYMBOL_PLAYER << COLOR_RESET;
-        dynamicDrawn = true;
+        frame.append(COLOR_PLAYER);
+        frame.append(SYMBOL_PLAYER);
+        frame.append(COLOR_RESET);
       }
       // Desenha os Zumbis
-      else {
-        for (auto &z : zombies) {
-          Point zp = z.getZombiePosition();
-          if (zp.x == x && zp.y == y) {
-            std::cout << COLOR_ZOMBIE << SYMBOL_ZOMBIE << COLOR_RESET;
-            dynamicDrawn = true;
-            break;
-          }
-        }
+      else if (occupancy[y][x] > 0) {
+        frame.append(COLOR_ZOMBIE);
+        frame.append(SYMBOL_ZOMBIE);
+        frame.append(COLOR_RESET);
+      } else if (grid[y][x] == SYMBOL_ITEM) {
+        frame.append(COLOR_ITEM);
+        frame.append(SYMBOL_ITEM);
+        frame.append(COLOR_RESET);
+      } else {
+        frame.append(grid[y][x]);
       }
-
-      if (!dynamicDrawn) {
-        if (grid[y][x] == SYMBOL_ITEM)
-          std::cout << COLOR_ITEM << SYMBOL_ITEM << COLOR_RESET;
-        else
-          std::cout << grid[y][x];
-      }
-      std::cout << " ";
+      frame.append(' ');
     }
-    std::cout << "\n";
+    frame.append('\n');
   }
+
+  // Uma única escrita por frame
+  out.write(frame.data(), frame.size());
 }
 
 bool Game::isRunning() const { return running; }
@@ -2,9 +2,19 @@
 #define GAME_H
 
 #include "config.h"
+#include "frame_buffer.h"
+#include "grid.h"
+#include "influence.h"
+#include "reservation.h"
+#include "snapshot.h"
+#include "timer_wheel.h"
+#include "visibility.h"
 #include "zombie.h"
 #include "zombie_spawner.h"
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -14,34 +24,94 @@ public:
   Game();
   ~Game();
 
-  // Setup principal
+  // Setup principal. init() sobe as threads que vivem entre rodadas (só
+  // na primeira vez) e chama resetRound()
   void init();
   void spawnItems();
 
+  // Nova rodada no mesmo objeto: mapa, player, placar e zumbis voltam ao
+  // início reaproveitando todos os buffers (sem realocar)
+  void resetRound();
+
+  // Termina a rodada atual (threads continuam vivas para a próxima)
+  void endRound();
+
   // Ações
   void updatePlayer();
-  void updateZombie(int zombieIndex);
   void checkNewZombies();
   void setPlayerDirection(Direction d);
 
-  // Renderização
-  void draw();
+  // Agendador: avança a TimerWheel até o relógio da rodada e despacha em
+  // lote o que venceu. Ondas, itens e cooldown de som saem da mesma roda.
+  // Os zumbis da vez (cada um na sua velocidade) andam num único tick em
+  // duas fases, com gameMutex travado do começo ao fim (antes delas o mapa
+  // de influência é recalculado, uma vez por tick):
+  // 1) proposeAll roda as propostas em paralelo (cada worker chama
+  //    proposeZombieMoves para a sua fatia); sem ele, roda tudo aqui
+  // 2) resolveZombieMoves decide os conflitos e aplica tudo de uma vez
+  // O resultado não depende de qual thread calculou cada proposta
+  void runTimers(const std::function<void()> &proposeAll = nullptr);
+
+#ifdef BENCH_HOOKS
+  // Só nos benchmarks: um tick com todos os zumbis andando, sem olhar os
+  // timers (runTimers depende do relógio de parede)
+  void updateZombies();
+#endif
+
+  // Quando o agendador precisa acordar: o próximo vencimento da roda.
+  // Se depois disso outra thread agendar algo para antes, wake é chamada
+  // (com gameMutex travado) para o agendador recalcular o prazo
+  std::chrono::steady_clock::time_point nextTimerDeadline();
+  void setTimerWakeup(const std::function<void()> &wake);
+
+  // Fase 1 para os zumbis first, first + stride, ... (só os da vez). Só
+  // dentro de runTimers: cada zumbi mexe apenas no seu estado
+  void proposeZombieMoves(int first, int stride);
+
+  // Snapshot do estado completo (grid, player, zumbis, spawner e RNG)
+  void saveSnapshot(GameSnapshot &out);
+  bool restoreSnapshot(const GameSnapshot &in);
+
+  // Renderização (por padrão no terminal)
+  void draw(std::ostream &out = std::cout);
 
   // Checagens de Estado
   bool isRunning() const;
   int getScore() const;
   int getLives() const;
 
+  // Posição livre (sem parede nem zumbi)? Chamar com gameMutex travado
+  bool isValidMove(Point p);
+
 private:
   // Estado de jogo
-  std::vector<std::string> grid;
+  Grid grid;
+  Occupancy occupancy; // Zumbis por célula (isValidMove e draw em O(1))
+  Visibility visibility; // O que o player enxerga (recalculado ao mover)
+  Influence influence;   // Distância ao player e territórios (por tick)
   Entity player;
   std::vector<Zombie> zombies;
   ZombieSpawner *spawner;
+  std::vector<Point> spawnBatch; // Lote recebido do spawner (reaproveitado)
+  std::vector<Point> proposals;  // Próxima célula de cada zumbi no tick
+  std::vector<Point> zombiePositions; // Fontes do mapa de influência
+  ReservationTable occupants;    // Quem está em cada célula (trocas)
+  ReservationTable reservations; // Quem fica com cada célula no tick
+  TimerWheel timers;             // Ações agendadas (protegida por gameMutex)
+  std::chrono::steady_clock::time_point roundClock; // Tick 0 da roda
+  uint64_t wakeTick; // Prazo com que o agendador foi dormir
+  std::function<void()> timerWakeup;
+  std::vector<TimerEvent> dueTimers; // Lote vencido em runTimers
+  std::vector<uint8_t> moveDue;  // Zumbi i anda neste tick?
+  TimerWheel::TimerId waveTimer; // Próxima onda
+  TimerWheel::TimerId itemTimer; // Próximo lote de itens (se agendado)
+  bool soundCooling[2];          // Som de coleta/dano em cooldown
   int score;
   int lives;
   int itemsRemaining;
   std::atomic<bool> running;
+  bool started; // Spawner e som já iniciados
+  FrameBuffer<GRID_WIDTH, GRID_HEIGHT> frame; // Tela montada pelo draw
 
   // Sincronização
   std::mutex gameMutex;  // Protege grid, vidas, e posições
@@ -49,9 +119,18 @@ private:
 
   // Helpers
   Point getNextPosition(Point current, Direction dir);
-
-  bool isValidMove(Point p);
   void handleDamaging();
+  void addZombie(const Zombie &z, uint32_t firstMoveIn = 0);
+  void moveZombie(int zombieIndex, Point p);
+  void removeZombie(int zombieIndex);
+  void stepZombies(const std::function<void()> &proposeAll);
+  void resolveZombieMoves();
+  void scheduleWave(uint32_t delayTicks);
+  uint64_t timerNow() const;
+  TimerWheel::TimerId scheduleTimer(uint32_t delayTicks, TimerKind kind,
+                                    int32_t target);
+  uint32_t timerRemaining(TimerWheel::TimerId id, uint64_t now) const;
+  void playSound(int type);
   void checkItemCollection(Point p);
 };
 
@@ -0,0 +1,222 @@
+#include "game_runtime.h"
+#include "frame_arena.h"
+#include "trace.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+GameRuntime::GameRuntime(KeyReader readKey)
+    : readKey(readKey), roundId(0), roundActive(false), shuttingDown(false),
+      parkedThreads(0), totalThreads(2), timersChanged(false),
+      helpersExit(false), quitFlag(false) {
+  game.setTimerWakeup([this]() {
+    std::lock_guard<std::mutex> lock(roundMutex);
+    timersChanged = true;
+    roundCv.notify_all();
+  });
+
+  // Todas as threads nascem aqui e vivem até o shutdown
+  inputThread = std::thread(&GameRuntime::inputWorker, this);
+  zombieThreads.emplace_back(&GameRuntime::schedulerWorker, this);
+  for (int i = 1; i < ZOMBIE_THREADS; ++i)
+    zombieThreads.emplace_back(&GameRuntime::zombieHelper, this, i);
+}
+
+GameRuntime::~GameRuntime() { shutdown(); }
+
+void GameRuntime::startRound() {
+  auto start = std::chrono::steady_clock::now();
+
+  // Primeira vez sobe spawner e som; depois só reinicia no lugar
+  game.init();
+  quitFlag = false;
+
+  {
+    std::lock_guard<std::mutex> lock(roundMutex);
+    roundActive = true;
+    roundId++;
+  }
+  roundCv.notify_all();
+
+  // Latência do reinício, como contador no trace (--trace)
+  auto end = std::chrono::steady_clock::now();
+  TRACE_COUNTER("restartMicros",
+                std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+                    .count());
+}
+
+void GameRuntime::runRound() {
+  // Loop Principal (Movimento do Player + Render + Timer)
+  auto startTime = std::chrono::steady_clock::now();
+
+  while (!quitFlag && game.isRunning()) {
+    // Verifica tempo decorrido
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::seconds>(now - startTime)
+            .count();
+    if (elapsed >= GAME_DURATION_SECONDS)
+      break;
+
+    {
+      FrameTick tick;
+      TRACE_SCOPE("main tick");
+
+      // Atualiza player e desenha o jogo
+      game.updatePlayer();
+      game.draw();
+
+      std::cout << "Time: " << (GAME_DURATION_SECONDS - elapsed) << "s"
+                << std::endl;
+    }
+
+    // Tick Sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(TICK_RATE_MS));
+  }
+}
+
+void GameRuntime::endRound() {
+  game.endRound();
+
+  // Acorda quem estiver dormindo e espera todas estacionarem
+  std::unique_lock<std::mutex> lock(roundMutex);
+  roundActive = false;
+  roundCv.notify_all();
+  roundCv.wait(lock, [this]() { return parkedThreads == totalThreads; });
+}
+
+void GameRuntime::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(roundMutex);
+    if (shuttingDown)
+      return;
+    shuttingDown = true;
+    roundActive = false;
+  }
+  game.endRound();
+  roundCv.notify_all();
+
+  if (inputThread.joinable())
+    inputThread.join();
+
+  // Primeiro o agendador (zombieThreads[0]): ele pode estar no meio de um
+  // proposeInParallel, esperando os helpers terminarem a fatia
+  if (zombieThreads[0].joinable())
+    zombieThreads[0].join();
+
+  // Agora nenhum tick pode começar: o único signal que falta é o de saída
+  helpersExit = true;
+  for (int i = 1; i < ZOMBIE_THREADS; ++i)
+    proposeStart[i].signal();
+  for (int i = 1; i < ZOMBIE_THREADS; ++i)
+    if (zombieThreads[i].joinable())
+      zombieThreads[i].join();
+
+  // Por último a de som: ninguém mais pede efeitos
+  stopSoundEffects();
+}
+
+bool GameRuntime::waitForRound(uint64_t &seenRound) {
+  std::unique_lock<std::mutex> lock(roundMutex);
+
+  parkedThreads++;
+  roundCv.notify_all(); // endRound pode estar esperando este contador
+  roundCv.wait(lock, [&]() {
+    return shuttingDown || (roundActive && roundId != seenRound);
+  });
+  parkedThreads--;
+
+  if (shuttingDown)
+    return false;
+  seenRound = roundId;
+  return true;
+}
+
+bool GameRuntime::sleepUnlessRoundEnds(int ms) {
+  std::unique_lock<std::mutex> lock(roundMutex);
+  return roundCv.wait_for(lock, std::chrono::milliseconds(ms),
+                          [this]() { return !roundActive || shuttingDown; });
+}
+
+bool GameRuntime::sleepUntilTimer(
+    std::chrono::steady_clock::time_point deadline) {
+  std::unique_lock<std::mutex> lock(roundMutex);
+  roundCv.wait_until(lock, deadline, [this]() {
+    return !roundActive || shuttingDown || timersChanged;
+  });
+  timersChanged = false;
+  return !roundActive || shuttingDown;
+}
+
+// 1. Thread de Input: Captura entrada do usuário
+void GameRuntime::inputWorker() {
+  uint64_t seenRound = 0;
+  traceSetThreadName("input");
+
+  while (waitForRound(seenRound)) {
+    while (!quitFlag && game.isRunning()) {
+      switch (readKey()) {
+        case 'w': game.setPlayerDirection(UP); break;
+        case 's': game.setPlayerDirection(DOWN); break;
+        case 'a': game.setPlayerDirection(LEFT); break;
+        case 'd': game.setPlayerDirection(RIGHT); break;
+        case 'q': quitFlag = true; break;
+      }
+      if (sleepUnlessRoundEnds(10))
+        break;
+    }
+  }
+}
+
+// 2. Agendador + threads de zumbi: o agendador despacha os timers vencidos
+// e divide as propostas entre todas (zumbis threadIndex,
+// threadIndex + ZOMBIE_THREADS, ...)
+void GameRuntime::schedulerWorker() {
+  uint64_t seenRound = 0;
+  traceSetThreadName("scheduler (zombie 0)");
+
+  while (waitForRound(seenRound)) {
+    while (game.isRunning()) {
+      // Nada vence antes do prazo: sem acordar a cada tick à toa
+      if (sleepUntilTimer(game.nextTimerDeadline()))
+        break;
+
+      FrameTick tick;
+      game.runTimers([this]() { proposeInParallel(); });
+    }
+  }
+}
+
+// Chamado dentro de runTimers, com o jogo travado pelo agendador
+void GameRuntime::proposeInParallel() {
+  for (int i = 1; i < ZOMBIE_THREADS; ++i)
+    proposeStart[i].signal();
+
+  game.proposeZombieMoves(0, ZOMBIE_THREADS);
+
+  for (int i = 1; i < ZOMBIE_THREADS; ++i)
+    proposeDone.wait();
+}
+
+// Só roda entre o signal e o wait do agendador: nunca toca no jogo fora
+// de um tick, então não precisa estacionar entre rodadas. helpersExit só
+// é ligado depois do join do agendador, então todo signal de fatia
+// recebe o seu proposeDone
+void GameRuntime::zombieHelper(int threadIndex) {
+  char name[32];
+  snprintf(name, sizeof(name), "zombie %d", threadIndex);
+  traceSetThreadName(name);
+
+  while (true) {
+    proposeStart[threadIndex].wait();
+    if (helpersExit)
+      break;
+
+    {
+      FrameTick tick;
+      game.proposeZombieMoves(threadIndex, ZOMBIE_THREADS);
+    }
+    proposeDone.signal();
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef GAME_RUNTIME_H
+#define GAME_RUNTIME_H
+
+#include "game.h"
+#include "semaphore.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Lê uma tecla sem bloquear; retorna -1 se nenhuma foi apertada
+typedef int (*KeyReader)();
+
+// Dono do Game e de todas as threads do jogo, vivo do início ao fim do
+// programa. Entre rodadas as threads ficam estacionadas numa variável de
+// condição e o Game é reiniciado no lugar, sem recriar nada
+class GameRuntime {
+public:
+  explicit GameRuntime(KeyReader readKey);
+  ~GameRuntime();
+
+  // Reinicia o Game e acorda as threads (latência vai para o trace)
+  void startRound();
+
+  // Loop principal (player + render + timer) até o tempo/vidas acabarem
+  // ou o jogador apertar 'q'
+  void runRound();
+
+  // Estaciona as threads; ao retornar nenhuma delas está tocando no Game
+  void endRound();
+
+  // Encerra e junta (join) todas as threads
+  void shutdown();
+
+  Game &getGame() { return game; }
+  bool quitRequested() const { return quitFlag; }
+
+private:
+  void inputWorker();
+
+  // Worker 0 é o agendador: dorme até o próximo vencimento da TimerWheel
+  // do jogo (zumbis, ondas, itens, sons), avança a roda e, quando há
+  // zumbis da vez, dispara as propostas; os outros só calculam a sua
+  // fatia quando chamados
+  void schedulerWorker();
+  void zombieHelper(int threadIndex);
+  void proposeInParallel();
+
+  // Espera a próxima rodada; false quando o runtime está encerrando
+  bool waitForRound(uint64_t &seenRound);
+
+  // Dorme até ms milissegundos; true se a rodada acabou nesse meio tempo
+  bool sleepUnlessRoundEnds(int ms);
+
+  // Dorme até deadline ou até o Game agendar algo antes disso; true se a
+  // rodada acabou nesse meio tempo
+  bool sleepUntilTimer(std::chrono::steady_clock::time_point deadline);
+
+  Game game;
+  KeyReader readKey;
+
+  std::thread inputThread;
+  std::vector<std::thread> zombieThreads;
+
+  // Controle das rodadas
+  std::mutex roundMutex;
+  std::condition_variable roundCv;
+  uint64_t roundId;
+  bool roundActive;
+  bool shuttingDown;
+  int parkedThreads;
+  int totalThreads; // Threads que estacionam (input + agendador)
+  bool timersChanged; // Game agendou algo antes do prazo do agendador
+
+  // Barreira da fase de propostas (índice 0 não é usado)
+  Semaphore proposeStart[ZOMBIE_THREADS];
+  Semaphore proposeDone;
+  std::atomic<bool> helpersExit;
+
+  std::atomic<bool> quitFlag;
+};
+
+#endif
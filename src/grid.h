@@ -0,0 +1,60 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "config.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Matriz W x H de tamanho fixo, guardada linha a linha num std::array.
+// Com W e H em tempo de compilação, o índice y * W + x vira constante
+// e o compilador consegue desenrolar os laços sobre vizinhos
+template <typename T, int W, int H> struct CellMap {
+  static constexpr int Width = W;
+  static constexpr int Height = H;
+  static constexpr int Size = W * H;
+
+  std::array<T, Size> cells;
+
+  // grid[y][x], como no antigo std::vector<std::string>
+  T *operator[](int y) { return cells.data() + y * W; }
+  const T *operator[](int y) const { return cells.data() + y * W; }
+
+  T &at(Point p) { return cells[index(p)]; }
+  const T &at(Point p) const { return cells[index(p)]; }
+
+  static constexpr int index(Point p) { return p.y * W + p.x; }
+  static constexpr bool inBounds(Point p) {
+    return p.x >= 0 && p.x < W && p.y >= 0 && p.y < H;
+  }
+
+  void fill(T value) { cells.fill(value); }
+};
+
+// Camada de paredes/itens
+template <int W, int H> using GridT = CellMap<char, W, H>;
+
+// Quantos zumbis há em cada célula
+template <int W, int H> using OccupancyT = CellMap<uint16_t, W, H>;
+
+// InfluenceMap e VisibilityField são instanciados só no tamanho do jogo
+// (fim de influence.cpp e visibility.cpp)
+static_assert(GRID_WIDTH == 20 && GRID_HEIGHT == 20,
+              "Adicione instanciações de InfluenceMap e VisibilityField para "
+              "GRID_WIDTH x GRID_HEIGHT em influence.cpp e visibility.cpp");
+
+// Tamanhos usados pelo jogo (config.h)
+using Grid = GridT<GRID_WIDTH, GRID_HEIGHT>;
+using Occupancy = OccupancyT<GRID_WIDTH, GRID_HEIGHT>;
+
+// Copia um mapa em texto para o grid; o que faltar vira parede
+template <int W, int H>
+void loadGrid(GridT<W, H> &grid, const std::vector<std::string> &rows) {
+  grid.fill(SYMBOL_WALL);
+  for (int y = 0; y < H && y < (int)rows.size(); ++y)
+    for (int x = 0; x < W && x < (int)rows[y].size(); ++x)
+      grid[y][x] = rows[y][x];
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "influence.h"
+
+template <int W, int H> InfluenceMap<W, H>::InfluenceMap() {
+  playerDist.fill(UNREACHABLE);
+  zombieDist.fill(UNREACHABLE);
+  owner.fill(NO_OWNER);
+  escapeDist.fill(UNREACHABLE);
+}
+
+template <int W, int H>
+void InfluenceMap<W, H>::compute(const GridT<W, H> &grid, Point player,
+                                 const Point *zombies, int count) {
+  // Distância até o player
+  playerDist.fill(UNREACHABLE);
+  int tail = 0;
+  if (GridT<W, H>::inBounds(player)) {
+    playerDist.at(player) = 0;
+    queue[tail++] = GridT<W, H>::index(player);
+  }
+  spread(grid, playerDist, tail, SPREAD_DISTANCE);
+
+  // Territórios: todos os zumbis entram na fila juntos, em ordem de índice.
+  // Zumbis empilhados na mesma célula: fica o primeiro
+  zombieDist.fill(UNREACHABLE);
+  owner.fill(NO_OWNER);
+  tail = 0;
+  for (int i = 0; i < count; ++i) {
+    Point p = zombies[i];
+    if (!GridT<W, H>::inBounds(p) || owner.at(p) != NO_OWNER)
+      continue;
+    zombieDist.at(p) = 0;
+    owner.at(p) = i;
+    queue[tail++] = GridT<W, H>::index(p);
+  }
+  spread(grid, zombieDist, tail, SPREAD_OWNER);
+
+  // Rotas de fuga: o player chega antes de qualquer zumbi. Delas para
+  // fora, cada território só é alcançado pela própria fronteira
+  escapeDist.fill(UNREACHABLE);
+  tail = 0;
+  for (int c = 0; c < W * H; ++c) {
+    if (playerDist.cells[c] < zombieDist.cells[c]) {
+      escapeDist.cells[c] = 0;
+      queue[tail++] = c;
+    }
+  }
+  spread(grid, escapeDist, tail, SPREAD_ESCAPE);
+}
+
+template <int W, int H>
+void InfluenceMap<W, H>::spread(const GridT<W, H> &grid,
+                                CellMap<int32_t, W, H> &dist, int tail,
+                                SpreadMode mode) {
+  auto visit = [&](int next, int curr) {
+    if (grid.cells[next] == SYMBOL_WALL || dist.cells[next] != UNREACHABLE)
+      return;
+    // Saindo da rota de fuga entra em qualquer território; dentro de um
+    // território, só segue no mesmo dono
+    if (mode == SPREAD_ESCAPE && dist.cells[curr] > 0 &&
+        owner.cells[next] != owner.cells[curr])
+      return;
+    dist.cells[next] = dist.cells[curr] + 1;
+    if (mode == SPREAD_OWNER)
+      owner.cells[next] = owner.cells[curr];
+    queue[tail++] = next;
+  };
+
+  int head = 0;
+  while (head < tail) {
+    int curr = queue[head++];
+    int x = curr % W, y = curr / W;
+
+    // Cima, Baixo, Esquerda, Direita (mesma ordem do Pathfinder)
+    if (y > 0)
+      visit(curr - W, curr);
+    if (y < H - 1)
+      visit(curr + W, curr);
+    if (x > 0)
+      visit(curr - 1, curr);
+    if (x < W - 1)
+      visit(curr + 1, curr);
+  }
+}
+
+template <int W, int H>
+Point InfluenceMap<W, H>::nextStep(Point from, int self) const {
+  if (!GridT<W, H>::inBounds(from) || playerDist.at(from) == UNREACHABLE)
+    return from;
+
+  const int dx[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
+  const int dy[] = {-1, 1, 0, 0};
+
+  // A saída do zumbi só vale se from é dele (empilhado: segue o de baixo)
+  bool flank = owner.at(from) == self && escapeDist.at(from) != UNREACHABLE;
+
+  Point best = from;
+  int32_t bestEscape = UNREACHABLE;
+  int32_t bestDist = UNREACHABLE;
+
+  for (int d = 0; d < 4; ++d) {
+    Point n = {from.x + dx[d], from.y + dy[d]};
+    if (!GridT<W, H>::inBounds(n))
+      continue;
+    int32_t dist = playerDist.at(n);
+    if (dist == UNREACHABLE) // Parede (ou ilha sem caminho)
+      continue;
+
+    // Rumo à saída: só pelo próprio território ou pela rota de fuga (a
+    // distância de uma célula alheia leva à saída do outro zumbi)
+    int32_t escape = 0;
+    if (flank) {
+      escape = escapeDist.at(n);
+      if (escape == UNREACHABLE || (escape > 0 && owner.at(n) != self))
+        continue;
+    }
+
+    if (escape < bestEscape || (escape == bestEscape && dist < bestDist)) {
+      best = n;
+      bestEscape = escape;
+      bestDist = dist;
+    }
+  }
+  return best;
+}
+
+// Instanciação explícita (tamanho do jogo; ver grid.h)
+template class InfluenceMap<20, 20>;
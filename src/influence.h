@@ -0,0 +1,67 @@
+#ifndef INFLUENCE_H
+#define INFLUENCE_H
+
+#include "config.h"
+#include "grid.h"
+#include <array>
+#include <cstdint>
+
+// Mapa de influência da horda, recalculado uma vez por tick:
+// - distância de cada célula até o player (um BFS a partir do player)
+// - território de cada zumbi: um único BFS com todos os zumbis como
+//   fonte marca, em cada célula, o zumbi que chega primeiro (empate fica
+//   com o menor índice)
+// - rotas de fuga: as células onde o player chega antes de qualquer
+//   zumbi. Um terceiro BFS, que parte delas e não cruza a fronteira entre
+//   territórios, dá a cada célula a distância até a rota de fuga que o
+//   dono dela cobre
+// Com isso cada zumbi escolhe o passo em O(1): vai para a saída do player
+// que fica do seu lado (pelo próprio território) e, lá dentro, desce a
+// distância até o player. Dois zumbis no mesmo corredor não fazem fila
+// indiana: o de trás não tem saída pela frente (é território do outro) e
+// dá a volta pela rota que ninguém cobre. Custo total O(células) por
+// tick, não importa quantos zumbis
+template <int W, int H> class InfluenceMap {
+public:
+  static constexpr int32_t UNREACHABLE = INT32_MAX;
+  static constexpr int32_t NO_OWNER = -1;
+
+  InfluenceMap();
+
+  // Recalcula os dois campos. zombies[i] é a posição do zumbi i
+  void compute(const GridT<W, H> &grid, Point player, const Point *zombies,
+               int count);
+
+  int32_t playerDistance(Point p) const { return playerDist.at(p); }
+  int32_t zombieDistance(Point p) const { return zombieDist.at(p); }
+  int32_t ownerAt(Point p) const { return owner.at(p); }
+  int32_t escapeDistance(Point p) const { return escapeDist.at(p); }
+
+  // Próximo passo do zumbi self em from. Se o território dele chega a uma
+  // rota de fuga: o vizinho (no território ou já na rota) mais perto dela,
+  // empate para o mais perto do player. Senão (encaixotado atrás de outros
+  // zumbis): o vizinho mais perto do player. from se o player está
+  // inalcançável
+  Point nextStep(Point from, int self) const;
+
+private:
+  enum SpreadMode {
+    SPREAD_DISTANCE, // Só a distância
+    SPREAD_OWNER,    // O vizinho novo herda o dono de onde veio
+    SPREAD_ESCAPE,   // Fora da rota de fuga, não cruza para outro dono
+  };
+
+  // BFS em dist a partir das células já enfileiradas em queue[0, tail)
+  void spread(const GridT<W, H> &grid, CellMap<int32_t, W, H> &dist,
+              int tail, SpreadMode mode);
+
+  CellMap<int32_t, W, H> playerDist;
+  CellMap<int32_t, W, H> zombieDist;
+  CellMap<int32_t, W, H> owner;
+  CellMap<int32_t, W, H> escapeDist; // 0 = rota de fuga do player
+  std::array<int, W * H> queue; // Cada célula entra no máximo uma vez
+};
+
+using Influence = InfluenceMap<GRID_WIDTH, GRID_HEIGHT>;
+
+#endif
@@ -1,8 +1,8 @@
+#include <cstdio>
+#include <cstring>
 #include <iostream>
-#include <thread>
-#include <chrono>
-#include <vector>
-#include "game.h"
+#include "game_runtime.h"
+#include "trace.h"
 
 // --- Includes específicos de SO ---
 #ifdef _WIN32
@@ -50,94 +50,43 @@ void setNonBlockingInput(bool enable) {
 #endif
 }
 
-// 1. Thread de Input: Captura entrada do usuário
-void inputThreadFunc(Game* game, bool* exitFlag) {
-    while (!(*exitFlag) && game->isRunning()) {
+// Lê uma tecla sem bloquear (-1 se nenhuma foi apertada)
+int readKeyNonBlocking() {
 #ifdef _WIN32
-        if (_kbhit()) {
-            char ch = _getch();
-            switch(ch) {
-                case 'w': game->setPlayerDirection(UP); break;
-                case 's': game->setPlayerDirection(DOWN); break;
-                case 'a': game->setPlayerDirection(LEFT); break;
-                case 'd': game->setPlayerDirection(RIGHT); break;
-                case 'q': *exitFlag = true; break; 
-            }
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (_kbhit()) return _getch();
+    return -1;
 #else
-        char ch = getchar();
-        if (ch != EOF) {
-            switch(ch) {
-                case 'w': game->setPlayerDirection(UP); break;
-                case 's': game->setPlayerDirection(DOWN); break;
-                case 'a': game->setPlayerDirection(LEFT); break;
-                case 'd': game->setPlayerDirection(RIGHT); break;
-                case 'q': *exitFlag = true; break; 
-            }
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10)); 
+    int ch = getchar();
+    return ch == EOF ? -1 : ch;
 #endif
-    }
-}
-
-// 2. Thread de Zumbi: Atualiza movimento do zumbi
-void zombieThreadFunc(Game* game, int zombieIndex) {
-    while (game->isRunning()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(int(TICK_RATE_MS / ZOMBIE_SPEED_MODIFIER)));
-        game->updateZombie(zombieIndex);
-    }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     char playAgain;
 
-    do {
-        enableWindowsANSI();
+    // --trace grava a linha do tempo de todas as threads em TRACE_FILE
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) traceEnable(true);
+    }
+    traceSetThreadName("main");
 
-        Game game;
-        game.init();
+    enableWindowsANSI();
 
+    // Game e threads são criados uma vez só; cada rodada reinicia no lugar
+    GameRuntime runtime(readKeyNonBlocking);
+    Game& game = runtime.getGame();
+
+    do {
         // Limpa a tela antes de começar
         std::cout << "\033[H\033[2J";
 
-        bool exitFlag = false;
-
-        // Começa a thread de entradas
         setNonBlockingInput(true);
-        std::thread inputThread(inputThreadFunc, &game, &exitFlag);
-
-        // Começa as threads de zumbis
-        std::vector<std::thread> zombieThreads;
-        for (int i = 0; i < ZOMBIE_COUNT; ++i) {
-            zombieThreads.emplace_back(zombieThreadFunc, &game, i);
-        }
+        runtime.startRound();
+        runtime.runRound();
 
-        // Loop Principal (Movimento do Player + Render + Timer)
-        auto startTime = std::chrono::steady_clock::now();
-        
-        while (!exitFlag && game.isRunning()) {
-            // Verifica tempo decorrido
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
-            if (elapsed >= GAME_DURATION_SECONDS) break;
-
-            // Atualiza player e desenha o jogo
-            game.updatePlayer();
-            game.draw();
-            
-            std::cout << "Time: " << (GAME_DURATION_SECONDS - elapsed) << "s" << std::endl;
-
-            // Tick Sleep
-            std::this_thread::sleep_for(std::chrono::milliseconds(TICK_RATE_MS));
-        }
-
-        // Limpeza ao sair
+        // Estaciona as threads antes de devolver o terminal
+        runtime.endRound();
         setNonBlockingInput(false); // Devolve o terminal ao estado normal
-        exitFlag = true; // Sinaliza threads para sair
-
-        inputThread.detach();
-        for (auto& t : zombieThreads) t.detach();
 
         std::cout << "\033[H\033[2J";
 
@@ -152,5 +101,11 @@ int main() {
         std::cin >> playAgain;
     } while (playAgain == 'y' || playAgain == 'Y');
 
+    runtime.shutdown();
+
+    if (traceEnabled()) {
+        if (traceWriteJson(TRACE_FILE)) std::cout << "Trace saved to " << TRACE_FILE << "\n";
+        else std::cout << "Could not write " << TRACE_FILE << "\n";
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -3,83 +3,87 @@
 #include "utils.h"
 #include <random>
 
-std::vector<std::string> generateRandomMap() {
-  static const std::vector<std::string> map0 = {
-    "####################",
-    "#..................#",
-    "#.###..######..###.#",
-    "#..#............#..#",
-    "#..#............#..#",
-    "#..................#",
-    "######........######",
-    "#..................#",
-    "#....##......##....#",
-    "#....#........#....#",
-    "#....#........#....#",
-    "#....##......##....#",
-    "#..................#",
-    "######........######",
-    "#..................#",
-    "#..#............#..#",
-    "#..#............#..#",
-    "#.###..######..###.#",
-    "#..................#",
-    "####################"
-  };
+static const std::vector<std::string> map0 = {
+  "####################",
+  "#..................#",
+  "#.###..######..###.#",
+  "#..#............#..#",
+  "#..#............#..#",
+  "#..................#",
+  "######........######",
+  "#..................#",
+  "#....##......##....#",
+  "#....#........#....#",
+  "#....#........#....#",
+  "#....##......##....#",
+  "#..................#",
+  "######........######",
+  "#..................#",
+  "#..#............#..#",
+  "#..#............#..#",
+  "#.###..######..###.#",
+  "#..................#",
+  "####################"
+};
 
-  static const std::vector<std::string> map1 = {
-    "####################",
-    "#..................#",
-    "#.###.###..###.###.#",
-    "#..................#",
-    "#.###.##....##.###.#",
-    "#.....##....##.....#",
-    "#####.##....##.#####",
-    "#..................#",
-    "#.###.###..###.###.#",
-    "#.#..............#.#",
-    "#.#..............#.#",
-    "#.###.###..###.###.#",
-    "#..................#",
-    "#####.##....##.#####",
-    "#.....##....##.....#",
-    "#.###.##....##.###.#",
-    "#..................#",
-    "#.###.###..###.###.#",
-    "#..................#",
-    "####################"
-  };
+static const std::vector<std::string> map1 = {
+  "####################",
+  "#..................#",
+  "#.###.###..###.###.#",
+  "#..................#",
+  "#.###.##....##.###.#",
+  "#.....##....##.....#",
+  "#####.##....##.#####",
+  "#..................#",
+  "#.###.###..###.###.#",
+  "#.#..............#.#",
+  "#.#..............#.#",
+  "#.###.###..###.###.#",
+  "#..................#",
+  "#####.##....##.#####",
+  "#.....##....##.....#",
+  "#.###.##....##.###.#",
+  "#..................#",
+  "#.###.###..###.###.#",
+  "#..................#",
+  "####################"
+};
 
-  static const std::vector<std::string> map2 = {
-    "####################",
-    "#..................#",
-    "#.##.##.##.##.##.###",
-    "#..................#",
-    "#.##..##....##..##.#",
-    "#..................#",
-    "#.##..##....##..##.#",
-    "#..................#",
-    "#.##.##......##.##.#",
-    "#..................#",
-    "#..................#",
-    "#.##.##......##.##.#",
-    "#..................#",
-    "#.##..##....##..##.#",
-    "#..................#",
-    "#.##..##....##..##.#",
-    "#..................#",
-    "#.##.##.##.##.##.###",
-    "#..................#",
-    "####################"
-  };
+static const std::vector<std::string> map2 = {
+  "####################",
+  "#..................#",
+  "#.##.##.##.##.##.###",
+  "#..................#",
+  "#.##..##....##..##.#",
+  "#..................#",
+  "#.##..##....##..##.#",
+  "#..................#",
+  "#.##.##......##.##.#",
+  "#..................#",
+  "#..................#",
+  "#.##.##......##.##.#",
+  "#..................#",
+  "#.##..##....##..##.#",
+  "#..................#",
+  "#.##..##....##..##.#",
+  "#..................#",
+  "#.##.##.##.##.##.###",
+  "#..................#",
+  "####################"
+};
 
-  // Seleciona um mapa aleatório
-  int choice = getRandom(0, 2);
-  std::vector<std::string> selectedMap;
+int getBuiltinMapCount() { return 3; }
+
+const std::vector<std::string> &getBuiltinMap(int index) {
+  if (index == 0) return map0;
+  else if (index == 1) return map1;
+  else return map2;
+}
 
-  if (choice == 0) selectedMap = map0;
-  else if (choice == 1) selectedMap = map1;
-  else selectedMap = map2;
+const std::vector<std::string> &pickRandomMap() {
+  // Seleciona um mapa aleatório
+  int choice = getRandom(0, getBuiltinMapCount() - 1);
+  return getBuiltinMap(choice);
+}
 
-  return selectedMap;
-}
\ No newline at end of file
+std::vector<std::string> generateRandomMap() { return pickRandomMap(); }
\ No newline at end of file
@@ -7,4 +7,11 @@
 // Gera e retorna um mapa aleatório 20x20
 std::vector<std::string> generateRandomMap();
 
+// Sorteia um dos mapas fixos sem copiar
+const std::vector<std::string> &pickRandomMap();
+
+// Acesso direto aos mapas fixos (index de 0 a getBuiltinMapCount() - 1)
+int getBuiltinMapCount();
+const std::vector<std::string> &getBuiltinMap(int index);
+
 #endif
\ No newline at end of file
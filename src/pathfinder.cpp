@@ -0,0 +1,93 @@
+#include "pathfinder.h"
+#include <memory>
+
+using namespace std;
+
+template <int W, int H> Pathfinder<W, H>::Pathfinder() : stamp(0) {
+  visited.fill(0);
+}
+
+// Função que calcula o BFS
+template <int W, int H>
+Point Pathfinder<W, H>::nextStep(const GridT<W, H> &grid, Point start,
+                                 Point target) {
+  // Se já está no alvo, não move
+  if (start == target)
+    return start;
+  if (!GridT<W, H>::inBounds(start) || !GridT<W, H>::inBounds(target))
+    return start;
+
+  // Novo carimbo invalida todas as visitas anteriores de uma vez
+  if (++stamp == 0) {
+    visited.fill(0);
+    stamp = 1;
+  }
+
+  const int startIdx = GridT<W, H>::index(start);
+  const int targetIdx = GridT<W, H>::index(target);
+
+  int head = 0, tail = 0;
+  queue[tail++] = startIdx;
+  visited[startIdx] = stamp;
+
+  // Marca e enfileira o vizinho se não for parede nem visitado
+  auto visit = [&](int next, int curr) {
+    if (grid.cells[next] == SYMBOL_WALL || visited[next] == stamp)
+      return;
+    visited[next] = stamp;
+    parent[next] = curr;
+    queue[tail++] = next;
+  };
+
+  bool found = false;
+  while (head < tail) {
+    int curr = queue[head++];
+
+    if (curr == targetIdx) {
+      found = true;
+      break;
+    }
+
+    // W é constante: divisão/resto viram multiplicações (ou shifts)
+    int x = curr % W, y = curr / W;
+
+    // Cima, Baixo, Esquerda, Direita
+    if (y > 0)
+      visit(curr - W, curr);
+    if (y < H - 1)
+      visit(curr + W, curr);
+    if (x > 0)
+      visit(curr - 1, curr);
+    if (x < W - 1)
+      visit(curr + 1, curr);
+  }
+
+  if (!found)
+    return start; // Sem caminho
+
+  // Backtracking para achar o primeiro passo
+  int curr = targetIdx;
+  while (parent[curr] != startIdx)
+    curr = parent[curr];
+
+  return {curr % W, curr / W};
+}
+
+// Um Pathfinder por thread e por tamanho. Alocado no primeiro uso: o de
+// 256x256 ocupa ~768KB e não cabe bem no TLS estático de cada thread
+template <int W, int H> static Pathfinder<W, H> &threadPathfinder() {
+  static thread_local unique_ptr<Pathfinder<W, H>> pathfinder;
+  if (!pathfinder)
+    pathfinder.reset(new Pathfinder<W, H>());
+  return *pathfinder;
+}
+
+Point findNextStep(const Grid &grid, Point start, Point target) {
+  return threadPathfinder<GRID_WIDTH, GRID_HEIGHT>().nextStep(grid, start,
+                                                              target);
+}
+
+// Instanciações explícitas (tamanhos dos benchmarks)
+template class Pathfinder<20, 20>;
+template class Pathfinder<64, 64>;
+template class Pathfinder<256, 256>;
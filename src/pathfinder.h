@@ -0,0 +1,32 @@
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include "config.h"
+#include "grid.h"
+#include <array>
+#include <cstdint>
+
+// BFS especializado para um grid W x H. Todo o estado fica em std::array
+// dentro do objeto: nenhuma alocação por chamada. O "visited" usa um
+// carimbo por busca, então não precisa ser limpo a cada chamada.
+// Instanciado em pathfinder.cpp para 20x20, 64x64 e 256x256
+template <int W, int H> class Pathfinder {
+public:
+  Pathfinder();
+
+  // Primeiro passo de start em direção a target (start se não há caminho)
+  Point nextStep(const GridT<W, H> &grid, Point start, Point target);
+
+private:
+  std::array<int, W * H> parent;        // Índice da célula anterior
+  std::array<int, W * H> queue;         // Fila do BFS (cada célula entra 1x)
+  std::array<uint32_t, W * H> visited;  // == stamp se visitada nesta busca
+  uint32_t stamp;
+};
+
+// Usa o Pathfinder da thread atual para o grid do jogo. O jogo persegue
+// pelo mapa de influência (influence.h); isto fica só para os benchmarks,
+// como referência de um BFS por zumbi
+Point findNextStep(const Grid &grid, Point start, Point target);
+
+#endif
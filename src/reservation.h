@@ -0,0 +1,46 @@
+#ifndef RESERVATION_H
+#define RESERVATION_H
+
+#include "config.h"
+#include "grid.h"
+#include <cstdint>
+
+// Tabela célula -> dono (índice do zumbi), válida só durante um tick.
+// Como no Pathfinder, um carimbo por tick dispensa limpar o mapa inteiro
+template <int W, int H> class ReservationTableT {
+public:
+  static constexpr int NO_OWNER = -1;
+
+  ReservationTableT() : stamp(1) { stamps.fill(0); }
+
+  // Esvazia a tabela em O(1)
+  void clear() {
+    if (++stamp == 0) {
+      stamps.fill(0);
+      stamp = 1;
+    }
+  }
+
+  // Dono da célula (NO_OWNER se livre)
+  int ownerAt(Point p) const {
+    return stamps.at(p) == stamp ? owners.at(p) : NO_OWNER;
+  }
+
+  // Reserva p para owner; false se a célula já tinha dono
+  bool claim(Point p, int owner) {
+    if (stamps.at(p) == stamp)
+      return false;
+    stamps.at(p) = stamp;
+    owners.at(p) = owner;
+    return true;
+  }
+
+private:
+  CellMap<int32_t, W, H> owners;
+  CellMap<uint32_t, W, H> stamps;
+  uint32_t stamp;
+};
+
+using ReservationTable = ReservationTableT<GRID_WIDTH, GRID_HEIGHT>;
+
+#endif
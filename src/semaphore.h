@@ -3,6 +3,7 @@
 
 #include <condition_variable>
 #include <mutex>
+#include "trace.h"
 
 class Semaphore {
 private:
@@ -20,8 +21,11 @@ public:
     std::unique_lock<std::mutex> lock(mtx);
 
     // Garantir que a thread não vai acordar
-    while (count == 0) {
-      cv.wait(lock);
+    if (count == 0) {
+      TRACE_SCOPE("Semaphore::wait"); // Só aparece no trace se bloqueou
+      while (count == 0) {
+        cv.wait(lock);
+      }
     }
 
     // Se saiu do while, é porque count > 0.
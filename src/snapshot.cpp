@@ -0,0 +1,66 @@
+#include "snapshot.h"
+
+void initSnapshotHeader(GameSnapshot &s) {
+  s.magic = SNAPSHOT_MAGIC;
+  s.version = SNAPSHOT_VERSION;
+  s.size = sizeof(GameSnapshot);
+}
+
+// Dentro do mapa e sem parede (no grid do próprio snapshot)
+static bool isOpenCell(const GameSnapshot &s, Point p) {
+  return p.x >= 0 && p.x < GRID_WIDTH && p.y >= 0 && p.y < GRID_HEIGHT &&
+         s.grid[p.y][p.x] != SYMBOL_WALL;
+}
+
+// UP..RIGHT ou NONE
+static bool isDirection(int32_t d) { return d >= UP && d <= NONE; }
+
+bool isSnapshotValid(const GameSnapshot &s) {
+  if (s.magic != SNAPSHOT_MAGIC || s.version != SNAPSHOT_VERSION ||
+      s.size != sizeof(GameSnapshot))
+    return false;
+
+  for (int y = 0; y < GRID_HEIGHT; ++y)
+    for (int x = 0; x < GRID_WIDTH; ++x) {
+      char c = s.grid[y][x];
+      if (c != SYMBOL_WALL && c != SYMBOL_EMPTY && c != SYMBOL_ITEM)
+        return false;
+    }
+
+  if (!isOpenCell(s, s.player.pos) || !isDirection(s.player.facing))
+    return false;
+  if (s.lives < 0 || s.lives > PLAYER_LIVES || s.score < 0)
+    return false;
+  if (s.itemsRemaining < 0 || s.itemsRemaining > ITEMS_BATCH_SIZE)
+    return false;
+
+  if (s.zombieCount < 0 || s.zombieCount > MAX_ZOMBIES)
+    return false;
+  for (int i = 0; i < s.zombieCount; ++i) {
+    const ZombieRecord &z = s.zombies[i];
+    if (!isOpenCell(s, z.pos) || !isDirection(z.heading))
+      return false;
+    if (z.moveTicks <= 0 || z.nextMoveIn <= 0)
+      return false;
+  }
+
+  if (s.spawnBatchCount < 0 || s.spawnBatchCount > SPAWN_QUEUE_CAPACITY)
+    return false;
+  int queued = 0;
+  for (int b = 0; b < s.spawnBatchCount; ++b) {
+    if (s.spawnBatchSizes[b] < 0 || s.spawnBatchSizes[b] > MAX_ZOMBIES)
+      return false;
+    queued += s.spawnBatchSizes[b];
+  }
+  if (queued > MAX_ZOMBIES)
+    return false;
+  for (int i = 0; i < queued; ++i)
+    if (!isOpenCell(s, s.spawnQueue[i]))
+      return false;
+
+  if (s.activeZombies < 0 || s.activeZombies > MAX_ZOMBIES)
+    return false;
+  if (s.waveNumber < 0 || s.nextWaveIn <= 0)
+    return false;
+  return true;
+}
@@ -0,0 +1,68 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "config.h"
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+// --- Formato do snapshot ---
+// Bloco plano e de tamanho fixo: salvar/restaurar é só uma cópia de memória,
+// sem nenhuma alocação por campo. Mudou o layout? Incrementa a versão.
+const uint32_t SNAPSHOT_MAGIC = 0x4A4F4753; // "SGOJ"
+const uint32_t SNAPSHOT_VERSION = 5;
+
+// Zumbi salvo: posição, estado de quando está vagando e velocidade
+struct ZombieRecord {
+  Point pos;
+  int32_t heading;    // Direction
+  uint32_t rngState;
+  int32_t moveTicks;  // Intervalo entre passos (ticks do agendador, > 0)
+  int32_t nextMoveIn; // Ticks até o próximo passo (> 0)
+};
+
+struct GameSnapshot {
+  // Cabeçalho
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size; // sizeof(GameSnapshot) de quem gravou
+
+  // Camada de itens/paredes do grid
+  char grid[GRID_HEIGHT][GRID_WIDTH];
+
+  // Estado do jogo
+  Entity player;
+  int32_t score;
+  int32_t lives;
+  int32_t itemsRemaining;
+
+  // Zumbis em campo
+  int32_t zombieCount;
+  ZombieRecord zombies[MAX_ZOMBIES];
+
+  // Lotes pendentes no buffer do spawner (pontos concatenados em ordem)
+  int32_t spawnBatchCount;
+  int32_t spawnBatchSizes[SPAWN_QUEUE_CAPACITY];
+  Point spawnQueue[MAX_ZOMBIES];
+  int32_t activeZombies;
+  int32_t waveNumber;
+  int32_t nextWaveIn; // Ticks até a próxima onda (> 0)
+
+  // Estado dos geradores aleatórios (jogo e ondas do spawner)
+  std::mt19937 rng;
+  std::mt19937 spawnerRng;
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+              "GameSnapshot precisa ser copiável byte a byte");
+
+// Preenche o cabeçalho do snapshot
+void initSnapshotHeader(GameSnapshot &s);
+
+// Verifica cabeçalho, contadores e cada registro: células conhecidas no
+// grid, posições dentro do mapa e fora de paredes, direções válidas e
+// tempos positivos. Não confia em arquivos de fora: o restore indexa o
+// grid com essas posições sem checar de novo
+bool isSnapshotValid(const GameSnapshot &s);
+
+#endif
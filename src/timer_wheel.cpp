@@ -0,0 +1,164 @@
+#include "timer_wheel.h"
+
+TimerWheel::TimerWheel(int capacity) : nodes(capacity) { clear(); }
+
+void TimerWheel::clear(uint64_t now) {
+  for (auto &level : slots)
+    for (TimerId &head : level)
+      head = NO_TIMER;
+
+  // Lista de livres encadeada pelo next
+  const int n = (int)nodes.size();
+  for (int i = 0; i < n; ++i) {
+    nodes[i].level = -1;
+    nodes[i].next = i + 1 < n ? i + 1 : NO_TIMER;
+  }
+  freeList = n > 0 ? 0 : NO_TIMER;
+  current = now;
+  used = 0;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint32_t delayTicks, TimerKind kind,
+                                         int32_t target) {
+  if (freeList == NO_TIMER)
+    return NO_TIMER;
+
+  TimerId id = freeList;
+  freeList = nodes[id].next;
+
+  Node &n = nodes[id];
+  n.expires = current + (delayTicks == 0 ? 1 : delayTicks);
+  n.event = {kind, target};
+  link(id);
+  used++;
+  return id;
+}
+
+void TimerWheel::cancel(TimerId id) {
+  if (id == NO_TIMER || nodes[id].level < 0)
+    return;
+  unlink(id);
+  nodes[id].level = -1;
+  nodes[id].next = freeList;
+  freeList = id;
+  used--;
+}
+
+void TimerWheel::retarget(TimerId id, int32_t target) {
+  if (id != NO_TIMER && nodes[id].level >= 0)
+    nodes[id].event.target = target;
+}
+
+uint32_t TimerWheel::remaining(TimerId id) const {
+  if (id == NO_TIMER || nodes[id].level < 0)
+    return 0;
+  return (uint32_t)(nodes[id].expires - current);
+}
+
+// Em cada nível os slots, a partir do atual, estão em ordem de
+// vencimento: o primeiro ocupado tem os menores daquele nível (o próprio
+// slot atual só guarda timers uma volta inteira à frente, por isso vem
+// por último). No nível 0 esse slot é um tick só; acima dele a lista é
+// percorrida. Um timer de nível alto pode vencer antes de um do nível 0
+// (só desce quando o relógio chega no seu slot): vale o menor de todos,
+// mas a lista é pulada se o slot inteiro começa depois do melhor achado
+uint64_t TimerWheel::nextExpiry() const {
+  uint64_t best = NO_EXPIRY;
+
+  for (int level = 0; level < LEVELS; ++level) {
+    const int shift = SLOT_BITS * level;
+    uint64_t at = (current >> shift) & SLOT_MASK;
+    for (int i = 1; i <= SLOTS; ++i) {
+      TimerId head = slots[level][(at + i) & SLOT_MASK];
+      if (head == NO_TIMER)
+        continue;
+      if ((((current >> shift) + i) << shift) >= best)
+        break;
+      for (TimerId id = head; id != NO_TIMER; id = nodes[id].next)
+        if (nodes[id].expires < best)
+          best = nodes[id].expires;
+      break;
+    }
+  }
+  return best;
+}
+
+// O nível sai da distância até o vencimento; o slot, dos bits do próprio
+// vencimento naquele nível
+void TimerWheel::link(TimerId id) {
+  Node &n = nodes[id];
+
+  const uint64_t range = 1ull << (SLOT_BITS * LEVELS);
+  if (n.expires - current >= range)
+    n.expires = current + range - 1; // Além da roda: vence no limite
+
+  uint64_t diff = n.expires - current;
+  int level = 0;
+  while (level < LEVELS - 1 && diff >= (1ull << (SLOT_BITS * (level + 1))))
+    level++;
+  int slot = (int)((n.expires >> (SLOT_BITS * level)) & SLOT_MASK);
+
+  n.level = (int16_t)level;
+  n.slot = (int16_t)slot;
+  n.prev = NO_TIMER;
+  n.next = slots[level][slot];
+  if (n.next != NO_TIMER)
+    nodes[n.next].prev = id;
+  slots[level][slot] = id;
+}
+
+void TimerWheel::unlink(TimerId id) {
+  Node &n = nodes[id];
+  if (n.prev != NO_TIMER)
+    nodes[n.prev].next = n.next;
+  else
+    slots[n.level][n.slot] = n.next;
+  if (n.next != NO_TIMER)
+    nodes[n.next].prev = n.prev;
+}
+
+void TimerWheel::cascade(int level) {
+  int slot = (int)((current >> (SLOT_BITS * level)) & SLOT_MASK);
+  TimerId id = slots[level][slot];
+  slots[level][slot] = NO_TIMER;
+
+  while (id != NO_TIMER) {
+    TimerId next = nodes[id].next;
+    link(id); // Agora mais perto: cai num nível abaixo
+    id = next;
+  }
+}
+
+int TimerWheel::advance(uint64_t to, std::vector<TimerEvent> &due) {
+  int count = 0;
+
+  while (current < to) {
+    current++;
+
+    // Nível L desce quando os níveis abaixo dele dão a volta juntos
+    for (int level = 1; level < LEVELS; ++level) {
+      if (((current >> (SLOT_BITS * (level - 1))) & SLOT_MASK) != 0)
+        break;
+      cascade(level);
+    }
+
+    // Tudo no slot atual do nível 0 vence exatamente agora
+    int slot = (int)(current & SLOT_MASK);
+    TimerId id = slots[0][slot];
+    slots[0][slot] = NO_TIMER;
+
+    while (id != NO_TIMER) {
+      Node &n = nodes[id];
+      TimerId next = n.next;
+      due.push_back(n.event);
+      count++;
+
+      n.level = -1;
+      n.next = freeList;
+      freeList = id;
+      used--;
+      id = next;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,86 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Tipos de ação agendada
+enum TimerKind : uint8_t {
+  TIMER_ZOMBIE_MOVE,    // target = índice do zumbi
+  TIMER_SPAWN_WAVE,     // Pede a próxima onda ao spawner
+  TIMER_ITEM_RESPAWN,   // Novo lote de itens
+  TIMER_SOUND_COOLDOWN, // target = tipo do som liberado de novo
+};
+
+struct TimerEvent {
+  TimerKind kind;
+  int32_t target;
+};
+
+// Timer wheel hierárquica (4 níveis de 64 slots, ticks de TIMER_TICK_MS).
+// O nível 0 tem um slot por tick; cada nível acima cobre 64x mais tempo e
+// é "descido" para o nível de baixo quando o relógio chega no seu slot.
+// Agendar e cancelar são O(1); avançar um tick é O(1) + os timers que
+// vencem ou descem de nível. Os timers ficam num pool de tamanho fixo
+// (listas duplamente ligadas por índice): nada é alocado depois do
+// construtor. Não é thread-safe: o Game usa com gameMutex travado
+class TimerWheel {
+public:
+  typedef int32_t TimerId;
+  static constexpr TimerId NO_TIMER = -1;
+  static constexpr uint64_t NO_EXPIRY = UINT64_MAX;
+
+  explicit TimerWheel(int capacity);
+
+  // Agenda kind/target para daqui a delayTicks (mínimo 1). NO_TIMER se o
+  // pool estiver cheio
+  TimerId schedule(uint32_t delayTicks, TimerKind kind, int32_t target);
+
+  // Cancela um timer pendente (NO_TIMER é ignorado)
+  void cancel(TimerId id);
+
+  // Troca o alvo de um timer pendente (zumbi mudou de índice)
+  void retarget(TimerId id, int32_t target);
+
+  // Ticks até o timer vencer (0 se não está pendente)
+  uint32_t remaining(TimerId id) const;
+
+  // Tick do próximo vencimento (NO_EXPIRY se não há nada pendente), para
+  // dormir até ele em vez de avançar tick a tick
+  uint64_t nextExpiry() const;
+
+  // Avança o relógio até o tick to e acrescenta em due tudo que venceu,
+  // na ordem dos ticks. Retorna quantos eventos vieram
+  int advance(uint64_t to, std::vector<TimerEvent> &due);
+
+  // Cancela tudo e põe o relógio em now
+  void clear(uint64_t now = 0);
+
+  uint64_t now() const { return current; }
+  int pending() const { return used; }
+
+private:
+  static constexpr int LEVELS = 4;
+  static constexpr int SLOT_BITS = 6;
+  static constexpr int SLOTS = 1 << SLOT_BITS;
+  static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+  void link(TimerId id);   // Coloca no slot certo para o tempo atual
+  void unlink(TimerId id); // Tira do slot (continua alocado)
+  void cascade(int level); // Desce o slot atual de level um nível
+
+  struct Node {
+    uint64_t expires;
+    TimerEvent event;
+    TimerId prev, next;
+    int16_t level, slot; // level < 0: livre
+  };
+
+  std::vector<Node> nodes;
+  TimerId slots[LEVELS][SLOTS]; // Cabeça de cada lista
+  TimerId freeList;
+  uint64_t current;
+  int used;
+};
+
+#endif
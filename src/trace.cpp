@@ -0,0 +1,135 @@
+#include "trace.h"
+#include "config.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct TraceEvent {
+  const char *name;
+  int64_t timestamp; // ns desde traceEpoch
+  int64_t value;     // Só para contadores
+  char phase;        // 'B', 'E' ou 'C' (como no formato do Chrome)
+};
+
+struct TraceBuffer {
+  int tid;
+  char name[32];
+  std::atomic<int> count;   // Eventos publicados (release pela dona)
+  std::atomic<int> dropped; // Eventos perdidos com o buffer cheio
+  int open; // 'B' gravados sem o 'E' ainda (só a dona mexe)
+  TraceEvent events[TRACE_BUFFER_EVENTS];
+};
+
+static const std::chrono::steady_clock::time_point traceEpoch =
+    std::chrono::steady_clock::now();
+
+// Todos os buffers já criados. Nunca são liberados: traceWriteJson lê os
+// das threads que já terminaram
+static std::mutex registryMutex;
+static std::vector<TraceBuffer *> registry;
+static thread_local TraceBuffer *localBuffer = nullptr;
+
+static int64_t traceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - traceEpoch)
+      .count();
+}
+
+// Buffer da thread atual (cria e registra na primeira chamada)
+static TraceBuffer *threadBuffer() {
+  if (!localBuffer) {
+    TraceBuffer *b = new TraceBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    b->tid = (int)registry.size() + 1;
+    snprintf(b->name, sizeof(b->name), "thread %d", b->tid);
+    registry.push_back(b);
+    localBuffer = b;
+  }
+  return localBuffer;
+}
+
+// Cada 'B' gravado deixa uma vaga reservada para o seu 'E': 'B' e 'C'
+// param de entrar open vagas antes do fim, e um 'E' sempre cabe. Assim o
+// buffer cheio nunca deixa um escopo aberto (ou um 'E' sem o 'B')
+static bool record(char phase, const char *name, int64_t value) {
+  TraceBuffer *b = threadBuffer();
+  int n = b->count.load(std::memory_order_relaxed);
+  int reserved = phase == 'E' ? 0 : b->open + (phase == 'B');
+  if (n + reserved >= TRACE_BUFFER_EVENTS) {
+    b->dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  b->events[n] = {name, traceNow(), value, phase};
+  b->count.store(n + 1, std::memory_order_release);
+  if (phase == 'B')
+    b->open++;
+  else if (phase == 'E')
+    b->open--;
+  return true;
+}
+
+void traceEnable(bool enable) { traceEnabledFlag() = enable; }
+
+void traceSetThreadName(const char *name) {
+  if (!traceEnabled())
+    return;
+  TraceBuffer *b = threadBuffer();
+  std::lock_guard<std::mutex> lock(registryMutex);
+  snprintf(b->name, sizeof(b->name), "%s", name);
+}
+
+bool traceBegin(const char *name) { return record('B', name, 0); }
+void traceEnd(const char *name) { record('E', name, 0); }
+void traceCounter(const char *name, int64_t value) {
+  record('C', name, value);
+}
+
+// Os nomes são literais do próprio código: não precisam de escape
+bool traceWriteJson(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return false;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  fprintf(f, "{\"traceEvents\":[\n");
+
+  bool first = true;
+  auto separator = [&]() {
+    if (!first)
+      fprintf(f, ",\n");
+    first = false;
+  };
+
+  for (TraceBuffer *b : registry) {
+    separator();
+    fprintf(f,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s\"}}",
+            b->tid, b->name);
+
+    int n = b->count.load(std::memory_order_acquire);
+    for (int i = 0; i < n; ++i) {
+      const TraceEvent &e = b->events[i];
+      double ts = e.timestamp / 1000.0; // O formato usa microssegundos
+      separator();
+      if (e.phase == 'C')
+        fprintf(f,
+                "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+                "\"tid\":%d,\"args\":{\"value\":%lld}}",
+                e.name, ts, b->tid, (long long)e.value);
+      else
+        fprintf(f,
+                "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,"
+                "\"tid\":%d}",
+                e.name, e.phase, ts, b->tid);
+    }
+
+    int dropped = b->dropped.load(std::memory_order_relaxed);
+    if (dropped > 0)
+      fprintf(stderr, "trace: %s perdeu %d eventos (buffer cheio)\n", b->name,
+              dropped);
+  }
+
+  fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+  return fclose(f) == 0;
+}
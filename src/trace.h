@@ -0,0 +1,87 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Trace de eventos no formato do Chrome (chrome://tracing / Perfetto).
+// Desligado por padrão: cada ponto de trace custa uma leitura atômica.
+// Ligado (--trace), cada thread grava num buffer próprio de tamanho fixo,
+// sem trava: só a dona escreve e o contador é publicado com release.
+// Os buffers vivem até o fim do programa e viram JSON em traceWriteJson
+
+// Liga/desliga a gravação (antes de criar as threads)
+void traceEnable(bool enable);
+
+inline std::atomic<bool> &traceEnabledFlag() {
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+inline bool traceEnabled() {
+  return traceEnabledFlag().load(std::memory_order_relaxed);
+}
+
+// Nomeia a thread atual no trace e já aloca o buffer dela. Chamar no
+// começo da thread, fora dos ticks
+void traceSetThreadName(const char *name);
+
+// Eventos. name precisa ser um literal (só o ponteiro é guardado).
+// traceBegin devolve false se o evento foi descartado (buffer quase
+// cheio): nesse caso o traceEnd correspondente não deve ser chamado
+bool traceBegin(const char *name);
+void traceEnd(const char *name);
+void traceCounter(const char *name, int64_t value);
+
+// Grava todos os buffers em path. false se não conseguiu abrir o arquivo
+bool traceWriteJson(const char *path);
+
+// Evento begin/end com o tempo de vida do escopo (o end só sai se o
+// begin foi gravado)
+class TraceScope {
+public:
+  explicit TraceScope(const char *name)
+      : name(traceEnabled() && traceBegin(name) ? name : nullptr) {}
+  ~TraceScope() {
+    if (name)
+      traceEnd(name);
+  }
+
+private:
+  const char *name;
+};
+
+// Trava m e registra quanto tempo a thread esperou por ela (só se houve
+// disputa). Substitui std::lock_guard nos mutexes que queremos observar
+class TracedLockGuard {
+public:
+  TracedLockGuard(std::mutex &m, const char *waitName) : m(m) {
+    if (!traceEnabled()) {
+      m.lock();
+      return;
+    }
+    if (m.try_lock())
+      return;
+    TraceScope wait(waitName);
+    m.lock();
+  }
+  ~TracedLockGuard() { m.unlock(); }
+
+  TracedLockGuard(const TracedLockGuard &) = delete;
+  TracedLockGuard &operator=(const TracedLockGuard &) = delete;
+
+private:
+  std::mutex &m;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_COUNTER(name, value)                                             \
+  do {                                                                         \
+    if (traceEnabled())                                                        \
+      traceCounter(name, value);                                               \
+  } while (0)
+
+#endif
@@ -1,4 +1,6 @@
 #include "utils.h"
+#include "semaphore.h"
+#include "trace.h"
 #include <random>
 #include <iostream>
 #include <thread>
@@ -13,23 +15,54 @@
   #include <unistd.h>
 #endif
 
-int getRandom(int min, int max) {
+std::mt19937 &getRandomEngine() {
   // Static pra inicializar só uma vez por programa/thread
   static std::random_device rd;
   static std::mt19937 gen(rd());
+  return gen;
+}
+
+int getRandom(int min, int max) {
   std::uniform_int_distribution<> dis(min, max);
-  return dis(gen);
+  return dis(getRandomEngine());
 }
 
-// Evita sobreposição de muitos sons (thread explosion)
-static std::atomic<bool> isPlaying(false);
+// Uma única thread de som, criada na primeira vez e reaproveitada até
+// stopSoundEffects (chamado pelo GameRuntime no shutdown). Criar uma
+// std::thread por efeito alocava dentro do tick do jogo. O destrutor
+// estático para e junta a thread de quem nunca chamou stopSoundEffects
+namespace {
+struct SoundWorker {
+  Semaphore requests;
+  std::atomic<int> pending{-1};
+  std::atomic<bool> stopping{false};
+  std::atomic<bool> isPlaying{false}; // Evita sobreposição de muitos sons
+  std::once_flag started;
+  std::thread thread;
 
-void playSoundEffect(int type) {
-  // Se já tiver um som tocando, ignoramos o novo para não "engarrafar" threads
-  if (isPlaying) return;
+  ~SoundWorker() { stop(); }
+
+  void stop() {
+    stopping = true;
+    requests.signal(); // Acorda a thread caso esteja esperando um som
+    if (thread.joinable())
+      thread.join();
+  }
+};
+} // namespace
+
+static SoundWorker sound;
+
+static void soundLoop() {
+  traceSetThreadName("sound");
+
+  while (true) {
+    sound.requests.wait();
+    if (sound.stopping) return;
+    int type = sound.pending.exchange(-1);
+    if (type < 0) continue;
 
-  std::thread([type]() {
-    isPlaying = true;
+    TRACE_SCOPE("playSound");
 
     #ifdef _WIN32
       if (type == 0) { // Item
@@ -50,6 +83,22 @@ void playSoundEffect(int type) {
       std::cout << "\033[10;750]\033[11;100]" << std::flush;
     #endif
 
-    isPlaying = false;
-  }).detach();
-}
\ No newline at end of file
+    sound.isPlaying = false;
+  }
+}
+
+void initSoundEffects() {
+  std::call_once(sound.started,
+                 []() { sound.thread = std::thread(soundLoop); });
+}
+
+void stopSoundEffects() { sound.stop(); }
+
+void playSoundEffect(int type) {
+  // Se já tiver um som tocando, ignoramos o novo para não "engarrafar" threads
+  if (sound.stopping || sound.isPlaying.exchange(true)) return;
+
+  initSoundEffects();
+  sound.pending = type;
+  sound.requests.signal();
+}
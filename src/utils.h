@@ -1,10 +1,22 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <random>
+
 // Gera um número aleatório entre min e max (inclusivo)
 // Implementação thread-safe
 int getRandom(int min, int max);
 
+// Gerador usado por getRandom (exposto para salvar/restaurar o estado)
+std::mt19937 &getRandomEngine();
+
+// Cria a thread de som (chamar fora do loop do jogo; playSoundEffect
+// também cria na primeira chamada se preciso)
+void initSoundEffects();
+
+// Para e junta (join) a thread de som; sons pedidos depois são ignorados
+void stopSoundEffects();
+
 // Toca um efeito sonoro baseado no tipo
 // type = 0 -> Som de coleta de item
 // type = 1 -> Som de dano ao player
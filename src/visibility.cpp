@@ -0,0 +1,94 @@
+#include "visibility.h"
+
+template <int W, int H> VisibilityField<W, H>::VisibilityField() : stamp(1) {
+  visible.fill(0);
+}
+
+// Fora do mapa conta como parede
+template <int W, int H>
+static bool blocksLight(const GridT<W, H> &grid, int x, int y) {
+  return x < 0 || x >= W || y < 0 || y >= H || grid[y][x] == SYMBOL_WALL;
+}
+
+template <int W, int H>
+void VisibilityField<W, H>::compute(const GridT<W, H> &grid, Point origin,
+                                    int radius) {
+  if (++stamp == 0) {
+    visible.fill(0);
+    stamp = 1;
+  }
+
+  if (!GridT<W, H>::inBounds(origin))
+    return;
+  visible.at(origin) = stamp;
+
+  // Transformações dos 8 octantes (xx, xy, yx, yy)
+  static const int mult[4][8] = {{1, 0, 0, -1, -1, 0, 0, 1},
+                                 {0, 1, -1, 0, 0, -1, 1, 0},
+                                 {0, 1, 1, 0, 0, -1, -1, 0},
+                                 {1, 0, 0, 1, -1, 0, 0, -1}};
+
+  for (int oct = 0; oct < 8; ++oct)
+    castLight(grid, origin, 1, 1.0f, 0.0f, radius, mult[0][oct],
+              mult[1][oct], mult[2][oct], mult[3][oct]);
+}
+
+// Varre um octante linha a linha. start/end são as inclinações ainda
+// iluminadas; cada parede encontrada divide o feixe e a parte de cima
+// continua numa chamada recursiva
+template <int W, int H>
+void VisibilityField<W, H>::castLight(const GridT<W, H> &grid, Point origin,
+                                      int row, float start, float end,
+                                      int radius, int xx, int xy, int yx,
+                                      int yy) {
+  if (start < end)
+    return;
+
+  const int radius2 = radius * radius;
+  float newStart = 0.0f;
+
+  for (int j = row; j <= radius; ++j) {
+    int dx = -j - 1, dy = -j;
+    bool blocked = false;
+
+    while (dx <= 0) {
+      dx++;
+
+      int x = origin.x + dx * xx + dy * xy;
+      int y = origin.y + dx * yx + dy * yy;
+      float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+      float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+
+      if (start < rightSlope)
+        continue;
+      if (end > leftSlope)
+        break;
+
+      // Célula dentro do feixe (paredes também aparecem iluminadas)
+      if (dx * dx + dy * dy <= radius2 && x >= 0 && x < W && y >= 0 && y < H)
+        visible[y][x] = stamp;
+
+      if (blocked) {
+        if (blocksLight(grid, x, y)) {
+          newStart = rightSlope;
+          continue;
+        }
+        blocked = false;
+        start = newStart;
+      } else if (blocksLight(grid, x, y) && j < radius) {
+        blocked = true;
+        castLight(grid, origin, j + 1, start, leftSlope, radius, xx, xy, yx,
+                  yy);
+        newStart = rightSlope;
+      }
+    }
+
+    if (blocked)
+      break;
+  }
+}
+
+// Instanciações explícitas: tamanho do jogo (ver grid.h) e o mapa grande
+// dos benchmarks
+template class VisibilityField<20, 20>;
+template class VisibilityField<256, 256>;
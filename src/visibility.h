@@ -0,0 +1,35 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include "config.h"
+#include "grid.h"
+#include <cstdint>
+
+// Campo de visão a partir de um ponto (o player), calculado uma vez por
+// movimento com shadowcasting recursivo sobre as paredes do grid. Depois
+// disso, "a célula p enxerga o player?" é uma leitura O(1).
+// Instanciado em visibility.cpp para o grid do jogo e 256x256 (benchmarks)
+template <int W, int H> class VisibilityField {
+public:
+  VisibilityField();
+
+  // Recalcula o campo a partir de origin, até radius células de distância
+  void compute(const GridT<W, H> &grid, Point origin, int radius);
+
+  // p está no campo de visão da última origem calculada?
+  bool isVisible(Point p) const {
+    return GridT<W, H>::inBounds(p) && visible.at(p) == stamp;
+  }
+
+private:
+  void castLight(const GridT<W, H> &grid, Point origin, int row, float start,
+                 float end, int radius, int xx, int xy, int yx, int yy);
+
+  // Carimbo por cálculo: não precisa limpar o mapa a cada movimento
+  CellMap<uint32_t, W, H> visible;
+  uint32_t stamp;
+};
+
+using Visibility = VisibilityField<GRID_WIDTH, GRID_HEIGHT>;
+
+#endif
@@ -1,72 +1,66 @@
 #include "zombie.h"
-#include <queue>
-#include <vector>
-
-using namespace std;
+#include <algorithm>
+
+Zombie::Zombie(Point position, Direction heading, uint32_t seed,
+               int moveTicks)
+    : zCoordinates(position), heading(heading), rngState(seed),
+      moveTicks(moveTicks), moveTimer(-1) {
+  // xorshift não sai do zero: deriva a semente da posição
+  if (rngState == 0)
+    rngState = 2654435761u * (uint32_t)(position.y * GRID_WIDTH + position.x + 1);
+
+  // Velocidade própria: intervalo base ± ZOMBIE_SPEED_SPREAD%
+  if (this->moveTicks <= 0) {
+    int base = int(TICK_RATE_MS / ZOMBIE_SPEED_MODIFIER) / TIMER_TICK_MS;
+    int spread = (int)(nextRandom() % (2 * ZOMBIE_SPEED_SPREAD + 1)) -
+                 ZOMBIE_SPEED_SPREAD;
+    this->moveTicks = std::max(1, base * (100 + spread) / 100);
+  }
+}
 
 // Calcula o próximo movimento do zumbi
-Point Zombie::calculateNextMove(Point target, const vector<string> &grid) {
-  Point nextStep = calculateBFS(zCoordinates, target, grid);
-  return nextStep;
+Point Zombie::calculateNextMove(int self, const Grid &grid,
+                                const Visibility &visibility,
+                                const Influence &influence) {
+  // Campo de visão é simétrico o bastante: se o player enxerga a célula do
+  // zumbi, o zumbi enxerga o player
+  if (!visibility.isVisible(zCoordinates))
+    return wander(grid);
+
+  // Campo do player e territórios já calculados no tick: passo em O(1)
+  return influence.nextStep(zCoordinates, self);
 }
 
-// Função que calcula o BFS
-Point Zombie::calculateBFS(Point start, Point target,
-                           const vector<string> &grid) {
-  // Se já está no alvo, não move
-  if (start.x == target.x && start.y == target.y)
-    return start;
-
-  int dx[] = {0, 0, -1, 1}; // Cima, Baixo, Esquerda, Direita
-  int dy[] = {-1, 1, 0, 0};
-
-  queue<Point> q;
-  q.push(start);
-
-  // Matrizes para rastrear caminh
-  vector<vector<Point>> parent(GRID_HEIGHT,
-                               vector<Point>(GRID_WIDTH, {-1, -1}));
-  vector<vector<bool>> visited(GRID_HEIGHT, vector<bool>(GRID_WIDTH, false));
-
-  visited[start.y][start.x] = true;
-  bool found = false;
-
-  while (!q.empty()) {
-    Point curr = q.front();
-    q.pop();
-
-    if (curr.x == target.x && curr.y == target.y) {
-      found = true;
-      break;
-    }
-
-    for (int i = 0; i < 4; i++) {
-      Point next = {curr.x + dx[i], curr.y + dy[i]};
+uint32_t Zombie::nextRandom() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
 
-      // Verifica limites e paredes
-      if (next.x >= 0 && next.x < GRID_WIDTH && next.y >= 0 &&
-          next.y < GRID_HEIGHT && grid[next.y][next.x] != SYMBOL_WALL &&
-          !visited[next.y][next.x]) {
+// Segue em frente até bater numa parede; às vezes vira numa bifurcação
+Point Zombie::wander(const Grid &grid) {
+  const int dx[] = {0, 0, -1, 1}; // UP, DOWN, LEFT, RIGHT
+  const int dy[] = {-1, 1, 0, 0};
 
-        visited[next.y][next.x] = true;
-        parent[next.y][next.x] = curr;
-        q.push(next);
-      }
-    }
-  }
+  auto isOpen = [&](int d) {
+    Point p = {zCoordinates.x + dx[d], zCoordinates.y + dy[d]};
+    return Grid::inBounds(p) && grid.at(p) != SYMBOL_WALL;
+  };
 
-  if (!found)
-    return start; // Sem caminho
+  // 1 em 4 chances de trocar de direção mesmo com caminho livre
+  if (heading != NONE && isOpen(heading) && nextRandom() % 4 != 0)
+    return {zCoordinates.x + dx[heading], zCoordinates.y + dy[heading]};
 
-  // Backtracking para achar o primeiro passo
-  Point curr = target;
-  while (!(parent[curr.y][curr.x].x == start.x &&
-           parent[curr.y][curr.x].y == start.y)) {
-    curr = parent[curr.y][curr.x];
+  int open[4];
+  int n = 0;
+  for (int d = 0; d < 4; ++d)
+    if (isOpen(d))
+      open[n++] = d;
 
-    if (curr.x == -1)
-      return start;
-  }
+  if (n == 0)
+    return zCoordinates; // Preso
 
-  return curr;
+  heading = (Direction)open[nextRandom() % n];
+  return {zCoordinates.x + dx[heading], zCoordinates.y + dy[heading]};
 }
@@ -2,29 +2,49 @@
 #define ZOMBIE_H
 
 #include "config.h"
-#include <string>
-#include <vector>
+#include "grid.h"
+#include "influence.h"
+#include "visibility.h"
+#include <cstdint>
 
 class Zombie {
 private:
   Point zCoordinates;
+  Direction heading;   // Direção atual enquanto vaga
+  uint32_t rngState;   // Gerador próprio (xorshift): sem disputa entre threads
+  int moveTicks;       // Intervalo entre passos (velocidade própria)
+  int32_t moveTimer;   // Próximo passo na TimerWheel do jogo
 
 public:
-  // Construtor
-  Zombie(Point position) { zCoordinates = position; }
+  // Construtor. moveTicks <= 0 sorteia a velocidade com o gerador do zumbi
+  Zombie(Point position, Direction heading = NONE, uint32_t seed = 0,
+         int moveTicks = 0);
 
   // Retorna a posição atual
-  Point getZombiePosition() { return zCoordinates; }
+  Point getZombiePosition() const { return zCoordinates; }
 
   // Define uma nova posição
   void setPosition(Point p) { zCoordinates = p; }
 
-  // Retorna a próxima posição
-  Point calculateNextMove(Point target, const std::vector<std::string> &grid);
+  // Estado para snapshot
+  Direction getHeading() const { return heading; }
+  uint32_t getRngState() const { return rngState; }
+
+  // Agendamento (ver TimerWheel)
+  int getMoveTicks() const { return moveTicks; }
+  int32_t getMoveTimer() const { return moveTimer; }
+  void setMoveTimer(int32_t id) { moveTimer = id; }
+
+  // Retorna a próxima posição do zumbi self (índice no vetor do jogo):
+  // persegue pelo mapa de influência (ver influence.h) se enxerga o
+  // player, senão vaga pelo mapa sem calcular caminho nenhum
+  Point calculateNextMove(int self, const Grid &grid,
+                          const Visibility &visibility,
+                          const Influence &influence);
 
 private:
-  // Usa BFS para calcular a posição do jogador
-  Point calculateBFS(Point start, Point target, const std::vector<std::string> &grid);
+  Point wander(const Grid &grid);
+  uint32_t nextRandom();
 };
 
-#endif
\ No newline at end of file
+#endif
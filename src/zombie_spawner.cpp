@@ -1,100 +1,362 @@
 #include "zombie_spawner.h"
 #include "config.h"
+#include "frame_arena.h"
+#include "trace.h"
 #include "utils.h"
-#include <chrono>
+#include <algorithm>
 #include <cstdlib>
 
 // Incializa as variáveis
-ZombieSpawner::ZombieSpawner(const Point *playerPosRef)
-    : items_sem(0), slots_sem(3), playerPos(playerPosRef), activeZombies(0) {
+ZombieSpawner::ZombieSpawner(WaveSettings settings)
+    : bufferIn(0), bufferOut(0), queuedBatches(0), items_sem(0),
+      slots_sem(SPAWN_QUEUE_CAPACITY), wave_sem(0), waitingForSlot(false),
+      wavePlayerPos({GRID_WIDTH / 2, GRID_HEIGHT / 2}),
+      rng(getRandomEngine()()), activeZombies(0), waveNumber(0),
+      settings(settings) {
   running = false;
+  roundActive = false;
+  roundId = 0;
+
+  // Reserva tudo de uma vez: as ondas não alocam durante o jogo
+  for (auto &slot : spawnBuffer)
+    slot.reserve(MAX_ZOMBIES);
+  waveBatch.reserve(MAX_ZOMBIES);
+  walls.fill(SYMBOL_WALL); // Sem mapa: nenhuma célula elegível
 }
 
 ZombieSpawner::~ZombieSpawner() { stop(); }
 
+void ZombieSpawner::setMap(const Grid &grid) { walls = grid; }
+
 // Cria thread para gerar zumbi
 void ZombieSpawner::start() {
+  if (spawnerThread.joinable())
+    return; // Já rodando
   running = true;
   spawnerThread = std::thread(&ZombieSpawner::producerLoop, this);
 }
 
 // Função para matar a thread
 void ZombieSpawner::stop() {
-  running = false;
+  {
+    // Só dá um slot ao produtor se ele está mesmo esperando um: um signal
+    // à toa deixaria slots_sem acima dos espaços vazios do buffer
+    std::lock_guard<std::mutex> lock(queueMutex);
+    running = false;
+    if (waitingForSlot)
+      slots_sem.signal();
+  }
   if (spawnerThread.joinable()) {
+    wave_sem.signal(); // Acorda o produtor caso esteja esperando uma onda
     spawnerThread.join();
   }
 }
 
-// Spawna o zumbi em uma das bordas.
-// Caso jogador presente em uma das bordas escolhidas, seleciona outra
-Point ZombieSpawner::generateBorderPosition() {
-  std::vector<Point> corners = {
-    {1, 1},                           // Canto Superior Esquerdo
-    {GRID_WIDTH - 2, 1},              // Canto Superior Direito
-    {1, GRID_HEIGHT - 2},             // Canto Inferior Esquerdo
-    {GRID_WIDTH - 2, GRID_HEIGHT - 2} // Canto Inferior Direito
-  };
-  std::vector<Point> validCorners;
-
-  // Filtra apenas os cantos onde o player NÃO está
-  for(auto p : corners) {
-    if(!(p.x == playerPos->x && p.y == playerPos->y)) 
-      validCorners.push_back(p);
-  }
-
-  // Escolhe um aleatório da lista filtrada
-  return validCorners[getRandom(0, validCorners.size() - 1)];
+void ZombieSpawner::beginRound(const Grid &grid) {
+  {
+    std::lock_guard<std::mutex> lock(roundMutex);
+    setMap(grid);
+    waveNumber = 0;
+    roundId++;
+  }
+
+  // Pedidos de onda que sobraram da rodada anterior
+  while (wave_sem.try_wait()) {
+  }
+
+  // Depois de trocar o roundId: o que o produtor inserir daqui em diante
+  // é da rodada nova, o que já estava no buffer sai aqui
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    drainBuffer();
+    activeZombies = 0;
+  }
+  roundActive = true;
 }
-// Código do produtor usando semáforos
+
+void ZombieSpawner::endRound() { roundActive = false; }
+
+void ZombieSpawner::requestWave(Point playerPos) {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    wavePlayerPos = playerPos;
+  }
+  wave_sem.signal();
+}
+
+// Descarta todos os lotes do buffer (libera os slots para o produtor).
+// Chamar com queueMutex travado
+void ZombieSpawner::drainBuffer() {
+  while (items_sem.try_wait()) {
+    spawnBuffer[bufferOut].clear();
+    bufferOut = (bufferOut + 1) % SPAWN_QUEUE_CAPACITY;
+    queuedBatches--;
+    slots_sem.signal();
+  }
+}
+
+// BFS a partir do player sobre as paredes: distância real (contornando
+// paredes) e, de quebra, quais células são alcançáveis
+void ZombieSpawner::computePlayerDistances(Point p) {
+  distance.fill(-1);
+
+  if (!Grid::inBounds(p))
+    return;
+
+  int dx[] = {0, 0, -1, 1}; // Cima, Baixo, Esquerda, Direita
+  int dy[] = {-1, 1, 0, 0};
+
+  int head = 0, tail = 0;
+  int start = Grid::index(p);
+  distance.cells[start] = 0;
+  bfsQueue[tail++] = start;
+
+  while (head < tail) {
+    int curr = bfsQueue[head++];
+    int cx = curr % GRID_WIDTH, cy = curr / GRID_WIDTH;
+
+    for (int i = 0; i < 4; i++) {
+      int nx = cx + dx[i], ny = cy + dy[i];
+      if (nx < 0 || nx >= GRID_WIDTH || ny < 0 || ny >= GRID_HEIGHT)
+        continue;
+
+      int next = ny * GRID_WIDTH + nx;
+      if (walls.cells[next] == SYMBOL_WALL || distance.cells[next] != -1)
+        continue;
+
+      distance.cells[next] = distance.cells[curr] + 1;
+      bfsQueue[tail++] = next;
+    }
+  }
+}
+
+// Monta a próxima onda: sorteia células alcançáveis a pelo menos
+// minDistance passos do player, sem repetir célula
+void ZombieSpawner::generateWave(std::vector<Point> &batch, Point player) {
+  batch.clear();
+
+  int size = settings.firstSize + waveNumber * settings.growth;
+  int room = MAX_ZOMBIES - activeZombies;
+  if (size > room)
+    size = room;
+  if (size <= 0)
+    return;
+
+  computePlayerDistances(player);
+
+  // Células elegíveis para spawn (temporário: arena da thread)
+  ArenaScope scope(threadArena());
+  int *candidates = threadArena().alloc<int>(Grid::Size);
+  int n = 0;
+  int farthest = 0;
+  for (int c = 0; c < Grid::Size; ++c) {
+    if (distance.cells[c] >= settings.minDistance)
+      candidates[n++] = c;
+    if (distance.cells[c] > farthest)
+      farthest = distance.cells[c];
+  }
+
+  // Mapa pequeno demais para a distância pedida: usa as mais distantes
+  if (n == 0 && farthest > 0) {
+    for (int c = 0; c < Grid::Size; ++c)
+      if (distance.cells[c] == farthest)
+        candidates[n++] = c;
+  }
+
+  if (size > n)
+    size = n;
+
+  // Fisher-Yates parcial: os primeiros size candidatos viram o lote
+  for (int i = 0; i < size; ++i) {
+    std::uniform_int_distribution<int> pick(i, n - 1);
+    int j = pick(rng);
+    std::swap(candidates[i], candidates[j]);
+    batch.push_back({candidates[i] % GRID_WIDTH, candidates[i] / GRID_WIDTH});
+  }
+
+  waveNumber++;
+}
+
+// Loop da thread produtora
 void ZombieSpawner::producerLoop() {
+  traceSetThreadName("spawner");
+
   // Loop do Produtor
   while (running) {
-    // Espera 6 segundos entre spawns
-    for (int i = 0; i < 60; ++i) { // 60 * 100ms = 6 segundos
-      if (!running) return;        // Saia se o jogo acabou (evita espera desnecessária)
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Dorme até o agendador do jogo pedir uma onda (ou o stop acordar)
+    wave_sem.wait();
+    if (!running) return;
+
+    // Pedidos acumulados enquanto o produtor estava bloqueado: uma onda só
+    while (wave_sem.try_wait()) {
     }
 
-    // Verifica limite de zumbis
-    if (activeZombies >= ZOMBIE_COUNT) {
-      break;
+    int round = roundId;
+    if (!roundActive)
+      continue;
+
+    Point player;
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      player = wavePlayerPos;
     }
 
-    // Posição de spawn do zumbi
-    Point spawnPos = generateBorderPosition();
+    FrameTick tick;
+    {
+      TRACE_SCOPE("generateWave");
+      std::lock_guard<std::mutex> lock(roundMutex);
+      if (round != roundId)
+        continue;
+      generateWave(waveBatch, player);
+    }
+    if (waveBatch.empty())
+      continue; // Limite de zumbis atingido
 
-    // Decrementa vazios
+    // Decrementa vazios (consumidor e beginRound liberam slots; stop() só
+    // se waitingForSlot). running é checado junto com o flag: ou o stop vê
+    // o produtor esperando, ou o produtor vê o stop
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      if (!running) return;
+      waitingForSlot = true;
+    }
     slots_sem.wait();
-
-    // Entra e sai da região crítica para adicionar zumbis na fila
     {
+      // Parando: o slot pego não é usado, e compensa o signal do stop
       std::lock_guard<std::mutex> lock(queueMutex);
-      spawnQueue.push(spawnPos);
+      waitingForSlot = false;
+      if (!running) return;
     }
 
-    // Incrementa o contador de cheios e sinaliza consumidor
-    items_sem.signal();
+    // Lote de uma rodada que já acabou: devolve o slot e descarta
+    if (!insertBatch(waveBatch, round))
+      slots_sem.signal();
+  }
+}
+
+// Código do produtor usando semáforos
+void ZombieSpawner::pushSpawnBatch(std::vector<Point> &batch) {
+  // Decrementa vazios
+  slots_sem.wait();
+  insertBatch(batch);
+}
 
-    activeZombies++;
+// Coloca o lote no próximo slot livre (o slot já foi reservado no slots_sem).
+// Com round >= 0 o lote só entra (e conta como ativo) se ainda for a mesma
+// rodada; a checagem fica dentro da região crítica, junto com a inserção
+bool ZombieSpawner::insertBatch(std::vector<Point> &batch, int round) {
+  // Entra e sai da região crítica para adicionar o lote no buffer
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (round >= 0) {
+      if (round != roundId)
+        return false;
+      activeZombies += (int)batch.size();
+    }
+    spawnBuffer[bufferIn].clear();
+    spawnBuffer[bufferIn].swap(batch);
+    bufferIn = (bufferIn + 1) % SPAWN_QUEUE_CAPACITY;
+    queuedBatches++;
+    TRACE_COUNTER("queuedBatches", queuedBatches);
   }
+
+  // Incrementa o contador de cheios e sinaliza consumidor
+  items_sem.signal();
+  return true;
 }
 
 // Código do consumidor usando semáforos
-bool ZombieSpawner::consumeSpawnPosition(Point &p) {
+bool ZombieSpawner::consumeSpawnBatch(std::vector<Point> &out) {
 
   // Tenta pegar sem bloquear o jogo
   if (items_sem.try_wait()) {
-    std::lock_guard<std::mutex> lock(queueMutex);
-
-    p = spawnQueue.front();
-    spawnQueue.pop();
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      out.clear();
+      out.swap(spawnBuffer[bufferOut]);
+      bufferOut = (bufferOut + 1) % SPAWN_QUEUE_CAPACITY;
+      queuedBatches--;
+    }
 
-    slots_sem.signal(); // Libera espaço na fila
+    slots_sem.signal(); // Libera espaço no buffer
     return true;
   }
   return false;
 }
 
+void ZombieSpawner::releaseZombies(int n) { activeZombies -= n; }
+
 // Retorna a quantidade de zumbis presentes no jogo
 int ZombieSpawner::getCurrentZombieCount() { return activeZombies; }
+
+int ZombieSpawner::getWaveNumber() { return waveNumber; }
+
+int ZombieSpawner::copySpawnQueue(Point *out, int maxPoints, int *sizes,
+                                  int maxBatches) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+
+  int copied = 0;
+  int batches = 0;
+  for (int k = 0; k < queuedBatches && batches < maxBatches; ++k) {
+    const std::vector<Point> &slot =
+        spawnBuffer[(bufferOut + k) % SPAWN_QUEUE_CAPACITY];
+    if (copied + (int)slot.size() > maxPoints)
+      break;
+
+    for (Point p : slot)
+      out[copied++] = p;
+    sizes[batches++] = (int)slot.size();
+  }
+  return batches;
+}
+
+void ZombieSpawner::copyRng(std::mt19937 &out) {
+  std::lock_guard<std::mutex> lock(roundMutex);
+  out = rng;
+}
+
+bool ZombieSpawner::restoreRound(const Grid &grid, const Point *in,
+                                 const int *sizes, int batchCount, int active,
+                                 int wave, const std::mt19937 &waveRng) {
+  if (batchCount < 0 || batchCount > SPAWN_QUEUE_CAPACITY)
+    return false;
+
+  // Produtor parado durante a troca: um pedido novo não pega slots
+  bool wasActive = roundActive.exchange(false);
+  {
+    std::lock_guard<std::mutex> lock(roundMutex);
+    setMap(grid);
+    waveNumber = wave;
+    rng = waveRng;
+    roundId++;
+  }
+
+  // Pedidos de onda de antes do snapshot
+  while (wave_sem.try_wait()) {
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    drainBuffer();
+    activeZombies = active;
+  }
+
+  // Com o buffer vazio todos os slots voltam: no máximo um está com o
+  // produtor, que falha no insertBatch (roundId mudou) e devolve. Por
+  // isso a espera fica fora do queueMutex
+  int offset = 0;
+  for (int b = 0; b < batchCount; ++b) {
+    slots_sem.wait();
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      spawnBuffer[bufferIn].assign(in + offset, in + offset + sizes[b]);
+      bufferIn = (bufferIn + 1) % SPAWN_QUEUE_CAPACITY;
+      queuedBatches++;
+    }
+    offset += sizes[b];
+    items_sem.signal();
+  }
+
+  roundActive = wasActive;
+  return true;
+}
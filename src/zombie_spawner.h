@@ -2,48 +2,129 @@
 #define ZOMBIE_SPAWNER_H
 
 #include "config.h"
+#include "grid.h"
 #include "semaphore.h"
 #include <atomic>
+#include <array>
 #include <mutex>
-#include <queue>
+#include <random>
 #include <thread>
+#include <vector>
+
+// Parâmetros das ondas (padrões em config.h)
+struct WaveSettings {
+  int intervalMs = WAVE_INTERVAL_MS;     // Tempo entre ondas
+  int firstSize = WAVE_FIRST_SIZE;       // Zumbis na primeira onda
+  int growth = WAVE_GROWTH;              // Zumbis a mais a cada onda
+  int minDistance = SPAWN_MIN_DISTANCE;  // Passos mínimos até o player
+};
 
 class ZombieSpawner {
 public:
-  // Recebe referência do playerPosition para calcular spawn longe dele
-  ZombieSpawner(const Point *playerPosRef);
+  // Gerador próprio, semeado pelo gerador global (getRandomEngine)
+  explicit ZombieSpawner(WaveSettings settings = WaveSettings());
   ~ZombieSpawner();
 
-  // Inicia a thread produtora
+  // Copia as paredes do mapa (chamar antes do start)
+  void setMap(const Grid &grid);
+
+  // Inicia a thread produtora (uma vez; ela é reaproveitada entre rodadas)
   void start();
 
   // Para a thread
   void stop();
 
-  // Retorna true se houver um zumbi para spawnar e preenche
-  bool consumeSpawnPosition(Point &p);
+  // Nova rodada: esvazia o buffer, zera ondas/contadores, copia o mapa e
+  // reinicia o intervalo da primeira onda. Lotes de rodadas anteriores
+  // ainda nas mãos do produtor são descartados
+  void beginRound(const Grid &grid);
+
+  // Pausa a produção até o próximo beginRound
+  void endRound();
+
+  // Pede a próxima onda ao produtor, longe de playerPos (lida pelo jogo
+  // com gameMutex travado; o spawner nunca lê a posição do player direto).
+  // Quem marca o ritmo (a cada getWaveIntervalMs) é o agendador do jogo; o
+  // produtor só espera o pedido. Pedidos que chegam enquanto ele está
+  // ocupado (buffer cheio) viram uma onda só, na posição mais recente
+  void requestWave(Point playerPos);
+  int getWaveIntervalMs() const { return settings.intervalMs; }
+
+  // Entrega um lote ao consumidor (bloqueia se o buffer estiver cheio).
+  // Troca o conteúdo com o slot do buffer: batch volta vazio
+  void pushSpawnBatch(std::vector<Point> &batch);
+
+  // Retorna true se houver um lote pronto e troca ele para out (sem
+  // bloquear). O conteúdo anterior de out é descartado
+  bool consumeSpawnBatch(std::vector<Point> &out);
+
+  // Avisa que n zumbis saíram do jogo (ou nem chegaram a entrar)
+  void releaseZombies(int n);
 
   // Retorna quantos zumbis ativos existem
   int getCurrentZombieCount();
 
+  // Número da próxima onda
+  int getWaveNumber();
+
+  // Copia os lotes pendentes (sem consumir) em ordem. Retorna quantos lotes
+  // copiou; sizes recebe o tamanho de cada um
+  int copySpawnQueue(Point *out, int maxPoints, int *sizes, int maxBatches);
+
+  // Estado do gerador das ondas (para o snapshot)
+  void copyRng(std::mt19937 &out);
+
+  // Volta ao estado de um snapshot como um beginRound: troca mapa, onda e
+  // gerador e muda o roundId (ondas montadas antes não entram mais), depois
+  // substitui os lotes pendentes e o contador de ativos. Pode esperar o
+  // produtor devolver um slot de um lote antigo. false se os lotes não
+  // cabem no buffer (nada é descartado em silêncio)
+  bool restoreRound(const Grid &grid, const Point *in, const int *sizes,
+                    int batchCount, int active, int wave,
+                    const std::mt19937 &waveRng);
+
+  // Gera a próxima onda em batch, longe de player (sem entregar). Usado
+  // pela thread produtora
+  void generateWave(std::vector<Point> &batch, Point player);
+
 private:
   void producerLoop();
-  Point generateBorderPosition();
+  bool insertBatch(std::vector<Point> &batch, int round = -1);
+  void drainBuffer();
+  void computePlayerDistances(Point player);
 
-  std::queue<Point> spawnQueue; // Buffer compartilhado
+  // Buffer limitado (circular) de lotes compartilhado com o jogo
+  std::vector<Point> spawnBuffer[SPAWN_QUEUE_CAPACITY];
+  int bufferIn;
+  int bufferOut;
+  int queuedBatches;
 
   // Sincronização
-  Semaphore items_sem; // Conta itens na fila (Full)
+  Semaphore items_sem; // Conta lotes no buffer (Full)
   Semaphore slots_sem; // Conta espaços vazios (Empty)
+  Semaphore wave_sem;  // Ondas pedidas pelo agendador (acumuladas viram uma)
   std::mutex queueMutex;
+  bool waitingForSlot; // Produtor parado no slots_sem (protegido por queueMutex)
 
   // Controle da Thread
   std::thread spawnerThread;
   std::atomic<bool> running;
+  std::atomic<bool> roundActive;
+  std::atomic<int> roundId;  // Muda a cada beginRound
+  std::mutex roundMutex;     // Protege mapa/onda/rng entre generateWave e o jogo
 
   // Estado do Jogo
-  const Point *playerPos;    // Ponteiro de leitura para posição do player
-  std::atomic<int> activeZombies; // Controla limite de 3
+  Point wavePlayerPos;       // Player no último requestWave (queueMutex)
+  std::mt19937 rng;          // Sorteio das ondas (só do spawner)
+  std::atomic<int> activeZombies; // Zumbis em campo ou a caminho
+  std::atomic<int> waveNumber;
+  WaveSettings settings;
+
+  // Buffers reaproveitados entre ondas (sem alocação durante o jogo)
+  Grid walls;                                      // Cópia do mapa
+  CellMap<int, GRID_WIDTH, GRID_HEIGHT> distance;  // Passos até o player
+  std::array<int, Grid::Size> bfsQueue;            // Fila do BFS (índices)
+  std::vector<Point> waveBatch;   // Lote montado pela thread produtora
 };
 
-#endif
\ No newline at end of file
+#endif